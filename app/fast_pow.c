@@ -1,7 +1,6 @@
+#include "fast_pow.h"
 #include <stdio.h>
 
-double fast_pow(double x, int n);
-
 int main() {
     double x;
     int n;
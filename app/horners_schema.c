@@ -1,9 +1,69 @@
+#include <errno.h>
+#include <fcntl.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
-int to_dec(char* str, int size, int base, long int * dec);
+#include "base_convert.h"
+#include "horners_schema.h"
+
+/*
+ * Без аргументов: одно число и основание со стандартного ввода.
+ * horners_schema FROM TO FILE [OUT]: перевод всех чисел файла FILE из
+ * системы FROM в TO, вывод в OUT или на стандартный вывод.
+ */
+static int run_batch(int argc, char **argv) {
+    int from = atoi(argv[1]);
+    int to = atoi(argv[2]);
+    int fd = STDOUT_FILENO;
+    if (argc > 4) {
+        fd = open(argv[4], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd < 0) {
+            perror(argv[4]);
+            return 1;
+        }
+    }
+
+    const char *out_name = argc > 4 ? argv[4] : "stdout";
+    base_convert_stats_t stats = { 0, 0 };
+    int status = base_convert_file(argv[3], from, to, fd, &stats);
+    int saved = errno;
+    // Отложенные ошибки записи (диск заполнен, NFS) могут всплыть только в close
+    if (fd != STDOUT_FILENO && close(fd) != 0 && status == BASE_OK) {
+        status = BASE_WRITE_ERROR;
+        saved = errno;
+    }
+    errno = saved;
+
+    switch (status) {
+        case BASE_OK:
+            return 0;
+        case BASE_BAD_BASE:
+            fprintf(stderr, "Base must be in 2..36\n");
+            break;
+        case BASE_BAD_DIGIT:
+            fprintf(stderr, "Invalid digit for base at offset %zu\n", stats.error_offset);
+            break;
+        case BASE_OVERFLOW:
+            fprintf(stderr, "Number too large at offset %zu\n", stats.error_offset);
+            break;
+        case BASE_NO_MEMORY:
+            fprintf(stderr, "Out of memory\n");
+            break;
+        case BASE_WRITE_ERROR:
+            perror(out_name);
+            break;
+        default:
+            perror(argv[3]);
+            break;
+    }
+    return 1;
+}
+
+int main(int argc, char **argv) {
+    if (argc >= 4) return run_batch(argc, argv);
 
-int main(void) {
     char s[256];
     int base;
     if (scanf("%255s %d", s, &base) == 2) {
@@ -0,0 +1,23 @@
+#ifndef BASE_CONVERT
+#define BASE_CONVERT
+
+#include <stddef.h>
+
+/*
+ * Потоковый перевод чисел из системы from_base в to_base. Число — это
+ * максимальная последовательность символов [0-9A-Za-z], всё остальное
+ * (переводы строк, запятые, знак минус...) копируется в вывод как есть.
+ * Коды возврата — BASE_* из horners_schema.h: BASE_IO_ERROR — не удалось
+ * прочитать вход, BASE_WRITE_ERROR — записать в fd; errno при этом сохранён.
+ */
+typedef struct {
+    size_t numbers;        /* переведено чисел */
+    size_t error_offset;   /* смещение неверного числа при BASE_BAD_DIGIT/BASE_OVERFLOW */
+} base_convert_stats_t;
+
+int base_convert_buffer(const char *data, size_t len, int from_base, int to_base, int fd,
+                        base_convert_stats_t *stats);
+int base_convert_file(const char *path, int from_base, int to_base, int fd,
+                      base_convert_stats_t *stats);
+
+#endif
@@ -0,0 +1,21 @@
+#ifndef BIGNUM_BASE
+#define BIGNUM_BASE
+
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * Неотрицательное число произвольной длины: limb[0] — младшие 64 бита,
+ * size — число значащих слов (0 для нуля). Коды возврата — BASE_* из
+ * horners_schema.h.
+ */
+typedef struct {
+    uint64_t *limb;
+    size_t size;
+} bignum_t;
+
+int bignum_parse(const char *str, size_t len, int base, bignum_t *out);
+char *bignum_format(const bignum_t *num, int base, size_t *len);
+void bignum_free(bignum_t *num);
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef BINARY_SEARCH
+#define BINARY_SEARCH
+
+int binary_search(const int arr[], int size, int target);
+void binary_search_batch(const int arr[], int size, const int targets[], int count, int out[]);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef CASCADE
+#define CASCADE
+
+/* Уровень каскада: слияние A_i с каждым вторым элементом уровня i + 1 */
+typedef struct {
+    int *keys;
+    int *a_pos;    /* lower bound ключа в исходном массиве A_i */
+    int *bridge;   /* lower bound ключа на уровне i + 1 */
+    int size;      /* без завершающего элемента-заглушки */
+} cascade_level_t;
+
+/* Дробный каскад над k отсортированными массивами */
+typedef struct {
+    cascade_level_t *levels;
+    int k;
+} cascade_t;
+
+cascade_t *cascade_build(const int *const arrays[], const int sizes[], int k);
+void cascade_destroy(cascade_t *c);
+
+void cascade_lower_bound(const cascade_t *c, int target, int out[]);
+
+#endif
@@ -0,0 +1,17 @@
+#ifndef EYTZINGER_SEARCH
+#define EYTZINGER_SEARCH
+
+/* Индекс для поиска в отсортированном массиве в раскладке Эйтцингера (BFS) */
+typedef struct {
+    int *data;   /* элементы в порядке обхода в ширину, data[0] не используется */
+    int *index;  /* index[k] — позиция data[k] в исходном массиве */
+    int size;
+} eytzinger_t;
+
+eytzinger_t *eytzinger_build(const int arr[], int size);
+void eytzinger_destroy(eytzinger_t *e);
+
+int eytzinger_lower_bound(const eytzinger_t *e, int target);
+int eytzinger_search(const eytzinger_t *e, int target);
+
+#endif
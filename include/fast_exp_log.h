@@ -0,0 +1,14 @@
+#ifndef FAST_EXP_LOG
+#define FAST_EXP_LOG
+
+#include <stddef.h>
+
+double fast_exp(double x);
+double fast_log(double x);
+double fast_pow_real(double x, double y);
+
+void fast_exp_batch(const double x[], size_t count, double out[]);
+void fast_log_batch(const double x[], size_t count, double out[]);
+void fast_pow_real_batch(const double x[], const double y[], size_t count, double out[]);
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef FAST_POW
+#define FAST_POW
+
+#include <stddef.h>
+
+double fast_pow(double x, int n);
+void fast_pow_batch(const double x[], const int n[], size_t count, double out[]);
+
+/*
+ * x^n по кратчайшей аддитивной цепочке для |n| <= 32 (x^15: x2, x3, x5, x10,
+ * x15 — 5 умножений против 6 у square-and-multiply). С константным n после
+ * встраивания (always_inline — иначе большой switch не встраивается) от
+ * него остаётся только нужная ветка — без цикла и проверок.
+ * Порядок умножений иной, чем в fast_pow, поэтому результат может отличаться
+ * в последних битах.
+ */
+#if defined(__GNUC__)
+#define FAST_POW_INLINE static inline __attribute__((always_inline))
+#else
+#define FAST_POW_INLINE static inline
+#endif
+
+FAST_POW_INLINE double fast_pow_chain(double x, int n) {
+    unsigned power = n < 0 ? 0u - (unsigned)n : (unsigned)n;
+    if (n < 0) {
+        x = 1.0 / x;
+    }
+    double x2, x3, x4, x5, x6, x7, x8, x9, x10, x13, x14, x16, x20;
+    switch (power) {
+    case 0: return 1.0;
+    case 1: return x;
+    case 2: return x * x;
+    case 3: x2 = x * x; return x2 * x;
+    case 4: x2 = x * x; return x2 * x2;
+    case 5: x2 = x * x; x4 = x2 * x2; return x4 * x;
+    case 6: x2 = x * x; x3 = x2 * x; return x3 * x3;
+    case 7: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; return x5 * x2;
+    case 8: x2 = x * x; x4 = x2 * x2; return x4 * x4;
+    case 9: x2 = x * x; x4 = x2 * x2; x8 = x4 * x4; return x8 * x;
+    case 10: x2 = x * x; x4 = x2 * x2; x5 = x4 * x; return x5 * x5;
+    case 11: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; return x10 * x;
+    case 12: x2 = x * x; x3 = x2 * x; x6 = x3 * x3; return x6 * x6;
+    case 13: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; return x10 * x3;
+    case 14: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x7 = x5 * x2; return x7 * x7;
+    case 15: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; return x10 * x5;
+    case 16: x2 = x * x; x4 = x2 * x2; x8 = x4 * x4; return x8 * x8;
+    case 17: x2 = x * x; x4 = x2 * x2; x8 = x4 * x4; x16 = x8 * x8; return x16 * x;
+    case 18: x2 = x * x; x3 = x2 * x; x6 = x3 * x3; x9 = x6 * x3; return x9 * x9;
+    case 19: x2 = x * x; x4 = x2 * x2; x8 = x4 * x4; x16 = x8 * x8; return x16 * x2 * x;
+    case 20: x2 = x * x; x4 = x2 * x2; x5 = x4 * x; x10 = x5 * x5; return x10 * x10;
+    case 21: x2 = x * x; x4 = x2 * x2; x5 = x4 * x; x10 = x5 * x5; x20 = x10 * x10; return x20 * x;
+    case 22: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; x = x10 * x; return x * x;
+    case 23: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; x13 = x10 * x3; return x13 * x10;
+    case 24: x2 = x * x; x3 = x2 * x; x6 = x3 * x3; x = x6 * x6; return x * x;
+    case 25: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; x20 = x10 * x10; return x20 * x5;
+    case 26: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; x13 = x10 * x3; return x13 * x13;
+    case 27: x2 = x * x; x3 = x2 * x; x6 = x3 * x3; x9 = x6 * x3; x = x9 * x9; return x * x9;
+    case 28: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x7 = x5 * x2; x14 = x7 * x7; return x14 * x14;
+    case 29: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x7 = x5 * x2; x14 = x7 * x7; return x14 * x14 * x;
+    case 30: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; x = x10 * x5; return x * x;
+    case 31: x2 = x * x; x3 = x2 * x; x5 = x3 * x2; x10 = x5 * x5; x20 = x10 * x10; return x20 * x10 * x;
+    case 32: x2 = x * x; x4 = x2 * x2; x8 = x4 * x4; x16 = x8 * x8; return x16 * x16;
+    default: {
+        // Большие n — встроенный square-and-multiply: с константой цикл разворачивается
+        double result = 1.0;
+        while (power > 0) {
+            if (power & 1) {
+                result *= x;
+            }
+            x *= x;
+            power >>= 1;
+        }
+        return result;
+    }
+    }
+}
+
+/* Для литерального показателя — fast_pow_chain, иначе обычный fast_pow */
+#if defined(__GNUC__)
+#define FAST_POW_CONST(x, n) (__builtin_constant_p(n) ? fast_pow_chain((x), (n)) : fast_pow((x), (n)))
+#else
+#define FAST_POW_CONST(x, n) fast_pow((x), (n))
+#endif
+
+#endif
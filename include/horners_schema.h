@@ -0,0 +1,24 @@
+#ifndef HORNERS_SCHEMA
+#define HORNERS_SCHEMA
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define BASE_OK        0
+#define BASE_BAD_DIGIT 1
+#define BASE_OVERFLOW  2
+#define BASE_BAD_BASE  3
+#define BASE_NO_SPACE  4
+#define BASE_IO_ERROR  5   /* чтение входа */
+#define BASE_NO_MEMORY 6
+#define BASE_WRITE_ERROR 7 /* запись вывода */
+
+int parse_base(const char *str, size_t len, int base, uint64_t *value);
+size_t base_span(const char *str, size_t len, int base);
+int to_dec(char* str, int size, int base, long int * dec);
+
+size_t base_length(uint64_t value, int base);
+int format_base(uint64_t value, int base, char *buf, size_t size, size_t *len);
+int from_dec(long int dec, int base, char* str, int size);
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef IOV_BUILDER
+#define IOV_BUILDER
+
+#include <stddef.h>
+#include <sys/uio.h>
+
+#define IOV_BUILDER_PIECES 64    /* кусков в одном writev */
+#define IOV_BUILDER_INLINE 1024  /* встроенный буфер для мелких кусков */
+#define IOV_BUILDER_SMALL  64    /* куски короче копируются во встроенный буфер */
+
+/*
+ * Вывод в дескриптор без склейки: куски запоминаются как (указатель, длина)
+ * и уходят одним writev. Куски от IOV_BUILDER_SMALL байт не копируются —
+ * их память должна жить до ближайшего iov_builder_flush (в том числе
+ * неявного, когда список кусков или встроенный буфер заполнен). Коды
+ * возврата — CONCAT_* из string_concatinate.h; первая ошибка запоминается,
+ * и дальнейшие куски отбрасываются.
+ */
+typedef struct {
+    int fd;
+    int status;
+    int count;
+    struct iovec iov[IOV_BUILDER_PIECES];
+    size_t inline_used;
+    char inline_buf[IOV_BUILDER_INLINE];
+} iov_builder_t;
+
+void iov_builder_init(iov_builder_t *b, int fd);
+void iov_builder_add(iov_builder_t *b, const char *ptr, size_t len);
+void iov_builder_add_copy(iov_builder_t *b, const char *ptr, size_t len);
+int iov_builder_flush(iov_builder_t *b);
+
+#endif
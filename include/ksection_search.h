@@ -0,0 +1,11 @@
+#ifndef KSECTION_SEARCH
+#define KSECTION_SEARCH
+
+#include <stdbool.h>
+
+/* Монотонный предикат: false ... false true ... true на [lo, hi) */
+typedef bool (*monotone_pred_t)(long x, void *ctx);
+
+long ksection_search(long lo, long hi, monotone_pred_t pred, void *ctx, int threads);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef LEARNED_INDEX
+#define LEARNED_INDEX
+
+#include <stdint.h>
+
+/* Отрезок кусочно-линейной модели: pos ~ first_pos + slope * (key - first_key) */
+typedef struct {
+    double slope;
+    int64_t last_key;   /* последний ключ, покрытый отрезком */
+    int first_pos;
+} learned_segment_t;
+
+/* Обученный индекс над отсортированным массивом (массив не копируется) */
+typedef struct {
+    const int *arr;
+    int size;
+    int eps;                    /* гарантированная ошибка предсказания позиции */
+    int64_t *seg_keys;          /* первые ключи отрезков — по ним ищется отрезок */
+    learned_segment_t *segs;
+    int seg_count;
+} learned_index_t;
+
+learned_index_t *learned_index_build(const int arr[], int size, int eps);
+void learned_index_destroy(learned_index_t *li);
+
+int learned_index_lower_bound(const learned_index_t *li, int target);
+int learned_index_search(const learned_index_t *li, int target);
+
+#endif
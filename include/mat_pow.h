@@ -0,0 +1,24 @@
+#ifndef MAT_POW
+#define MAT_POW
+
+#include <stddef.h>
+#include <stdint.h>
+#include "mod_pow.h"
+
+/*
+ * Квадратные матрицы n x n, хранятся построчно. Результат умножения не
+ * должен пересекаться с операндами. mat_pow_* возвращают 0 или -1 при
+ * нехватке памяти.
+ */
+void mat_mul_f64(size_t n, const double *a, const double *b, double *c);
+int mat_pow_f64(size_t n, const double *a, uint64_t e, double *out);
+
+/* Целые по модулю 2^64 (переполнение — обычное беззнаковое) */
+void mat_mul_u64(size_t n, const uint64_t *a, const uint64_t *b, uint64_t *c);
+int mat_pow_u64(size_t n, const uint64_t *a, uint64_t e, uint64_t *out);
+
+/* По модулю ctx->mod; элементы — обычные вычеты */
+void mat_mul_mod(const mod_ctx_t *ctx, size_t n, const uint64_t *a, const uint64_t *b, uint64_t *c);
+int mat_pow_mod(const mod_ctx_t *ctx, size_t n, const uint64_t *a, uint64_t e, uint64_t *out);
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef MMAP_SEARCH
+#define MMAP_SEARCH
+
+#include <stddef.h>
+
+/*
+ * Поиск в файле из записей фиксированной длины, отсортированных по ключу int,
+ * лежащему по смещению key_offset внутри записи. Файл отображается в память
+ * (mmap), в памяти процесса хранится только первый ключ каждой страницы.
+ */
+typedef struct {
+    int fd;
+    const unsigned char *base;
+    size_t file_size;
+    size_t record_size;
+    size_t key_offset;
+    size_t count;         /* записей в файле */
+    size_t per_page;      /* записей в одной «странице» индекса */
+    int *page_keys;       /* первый ключ каждой страницы */
+    size_t page_count;
+} mmap_search_t;
+
+mmap_search_t *mmap_search_open(const char *path, size_t record_size, size_t key_offset);
+void mmap_search_close(mmap_search_t *ms);
+
+size_t mmap_search_lower_bound(const mmap_search_t *ms, int key);
+const void *mmap_search_find(const mmap_search_t *ms, int key);
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef MOD_POW
+#define MOD_POW
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Умножение 64 x 64 -> 128 и встраиваемые редукции ниже опираются на __int128 */
+#if !defined(__SIZEOF_INT128__)
+#error "mod_pow.h requires unsigned __int128 (GCC or Clang on a 64-bit target)"
+#endif
+
+/* Предвычисленные константы для одного модуля */
+typedef struct {
+    uint64_t mod;
+    bool montgomery;        /* нечётный модуль — Монтгомери, иначе Барретт */
+    uint64_t inv;           /* mod^-1 mod 2^64 (Монтгомери) */
+    uint64_t r2;            /* R^2 mod mod, R = 2^64 (Монтгомери) */
+    uint64_t one;           /* R mod mod — единица в форме Монтгомери */
+    unsigned __int128 mu;   /* floor((2^128 - 1) / mod) (Барретт) */
+} mod_ctx_t;
+
+int mod_ctx_init(mod_ctx_t *ctx, uint64_t mod);
+
+/* REDC: t / R mod m для t < m * R */
+static inline uint64_t mod_mont_reduce(const mod_ctx_t *ctx, unsigned __int128 t) {
+    uint64_t k = (uint64_t)t * ctx->inv;
+    uint64_t km_hi = (uint64_t)(((unsigned __int128)k * ctx->mod) >> 64);
+    uint64_t t_hi = (uint64_t)(t >> 64);
+    uint64_t r = t_hi - km_hi; // младшие половины t и k * m совпадают
+    return t_hi < km_hi ? r + ctx->mod : r;
+}
+
+/* Старшие 128 бит произведения 128 x 128 */
+static inline unsigned __int128 mod_mul_hi_128(unsigned __int128 a, unsigned __int128 b) {
+    uint64_t a0 = (uint64_t)a, a1 = (uint64_t)(a >> 64);
+    uint64_t b0 = (uint64_t)b, b1 = (uint64_t)(b >> 64);
+    unsigned __int128 p00 = (unsigned __int128)a0 * b0;
+    unsigned __int128 p01 = (unsigned __int128)a0 * b1;
+    unsigned __int128 p10 = (unsigned __int128)a1 * b0;
+    unsigned __int128 p11 = (unsigned __int128)a1 * b1;
+    unsigned __int128 mid = (p00 >> 64) + (uint64_t)p01 + (uint64_t)p10;
+    return p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+}
+
+static inline uint64_t mod_barrett_reduce(const mod_ctx_t *ctx, unsigned __int128 x) {
+    unsigned __int128 q = mod_mul_hi_128(x, ctx->mu);
+    unsigned __int128 r = x - q * ctx->mod;
+    while (r >= ctx->mod) r -= ctx->mod;
+    return (uint64_t)r;
+}
+
+/*
+ * «Рабочая форма» вычетов: форма Монтгомери для нечётного модуля, обычная —
+ * для чётного. Длинные цепочки умножений (степени, матрицы) переводят
+ * операнды в неё один раз, умножают mod_form_mul и возвращают результат.
+ */
+static inline uint64_t mod_form_mul(const mod_ctx_t *ctx, uint64_t a, uint64_t b) {
+    if (ctx->montgomery) return mod_mont_reduce(ctx, (unsigned __int128)a * b);
+    return mod_barrett_reduce(ctx, (unsigned __int128)a * b);
+}
+
+static inline uint64_t mod_form_in(const mod_ctx_t *ctx, uint64_t a) {
+    a %= ctx->mod;
+    return ctx->montgomery ? mod_mont_reduce(ctx, (unsigned __int128)a * ctx->r2) : a;
+}
+
+static inline uint64_t mod_form_out(const mod_ctx_t *ctx, uint64_t a) {
+    return ctx->montgomery ? mod_mont_reduce(ctx, a) : a;
+}
+
+static inline uint64_t mod_form_add(const mod_ctx_t *ctx, uint64_t a, uint64_t b) {
+    uint64_t s = a + b;
+    return (s >= ctx->mod || s < a) ? s - ctx->mod : s;
+}
+
+uint64_t mod_mul(const mod_ctx_t *ctx, uint64_t a, uint64_t b);
+uint64_t mod_pow(const mod_ctx_t *ctx, uint64_t base, uint64_t exp);
+void mod_pow_batch(const mod_ctx_t *ctx, const uint64_t bases[], const uint64_t exps[],
+                   size_t count, uint64_t out[]);
+
+#endif
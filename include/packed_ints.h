@@ -0,0 +1,33 @@
+#ifndef PACKED_INTS
+#define PACKED_INTS
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define PACKED_INTS_BLOCK 128
+
+/*
+ * Сжатый отсортированный массив int: блоки по PACKED_INTS_BLOCK элементов,
+ * первый элемент блока хранится в heads, остальные — разностями с
+ * предыдущим, упакованными по bits[b] бит.
+ */
+typedef struct {
+    int *heads;            /* первый элемент каждого блока — массив для поиска */
+    uint32_t *offset;      /* начало упакованных разностей блока в words */
+    uint8_t *bits;         /* ширина разности в блоке, 0..32 */
+    uint32_t *words;
+    size_t word_count;
+    int size;
+    int block_count;
+} packed_ints_t;
+
+packed_ints_t *packed_ints_build(const int arr[], int size);
+void packed_ints_destroy(packed_ints_t *p);
+
+int packed_ints_decode_block(const packed_ints_t *p, int block, int out[PACKED_INTS_BLOCK]);
+int packed_ints_get(const packed_ints_t *p, int i);
+int packed_ints_lower_bound(const packed_ints_t *p, int target);
+int packed_ints_search(const packed_ints_t *p, int target);
+size_t packed_ints_bytes(const packed_ints_t *p);
+
+#endif
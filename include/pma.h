@@ -0,0 +1,29 @@
+#ifndef PMA
+#define PMA
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/*
+ * Packed-memory array: отсортированный массив int с пропусками.
+ * Массив разбит на сегменты по seg_size ячеек, элементы каждого сегмента
+ * прижаты к его началу, пустое место — в конце сегмента.
+ */
+typedef struct {
+    int *data;
+    int *seg_count;     /* число элементов в каждом сегменте */
+    size_t seg_size;
+    size_t seg_num;     /* степень двойки */
+    size_t count;
+} pma_t;
+
+pma_t *pma_create(void);
+void pma_destroy(pma_t *p);
+
+int pma_insert(pma_t *p, int value);
+/* 1 — удалён, 0 — не найден, -1 — нет памяти (массив не изменён) */
+int pma_delete(pma_t *p, int value);
+bool pma_contains(const pma_t *p, int value);
+size_t pma_scan(const pma_t *p, int from, int out[], size_t max);
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef POLYNOMIAL
+#define POLYNOMIAL
+
+#include <stddef.h>
+
+/*
+ * Многочлен степени degree задаётся degree + 1 коэффициентами по
+ * возрастанию степеней: coef[0] + coef[1] * x + ... + coef[degree] * x^degree.
+ */
+double poly_horner(const double coef[], size_t degree, double x);
+double poly_estrin(const double coef[], size_t degree, double x);
+
+void poly_eval_batch(const double coef[], size_t degree, const double x[], size_t count, double out[]);
+
+#endif
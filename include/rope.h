@@ -0,0 +1,34 @@
+#ifndef ROPE
+#define ROPE
+
+#include <stddef.h>
+
+/*
+ * Строка-верёвка: сбалансированное (AVL) дерево кусков до ROPE_LEAF_MAX
+ * байт. Узлы неизменяемы и разделяются между верёвками по счётчику
+ * ссылок, поэтому подстрока и склейка не копируют текст. Непрерывный
+ * буфер строится только по запросу (rope_flatten) и живёт до следующего
+ * изменения.
+ */
+typedef struct rope_node rope_node_t;
+
+typedef struct {
+    rope_node_t *root;
+    char *flat;         /* кэш rope_flatten или NULL */
+} rope_t;
+
+rope_t *rope_create(void);
+void rope_destroy(rope_t *r);
+
+size_t rope_length(const rope_t *r);
+char rope_at(const rope_t *r, size_t pos);
+size_t rope_copy(const rope_t *r, size_t pos, size_t len, char *out);
+const char *rope_flatten(rope_t *r);
+
+int rope_append(rope_t *r, const char *s, size_t len);
+int rope_insert(rope_t *r, size_t pos, const char *s, size_t len);
+int rope_concat(rope_t *r, const rope_t *other);
+rope_t *rope_split(rope_t *r, size_t pos);
+rope_t *rope_substr(const rope_t *r, size_t pos, size_t len);
+
+#endif
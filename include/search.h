@@ -0,0 +1,125 @@
+#ifndef SEARCH_DEF
+
+#include <stddef.h>
+
+#if defined(__GNUC__)
+#define SEARCH_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define SEARCH_PREFETCH(p) ((void)0)
+#endif
+
+/* Ключ элемента — сам элемент; сравнение — встроенный оператор < */
+#define SEARCH_KEY_SELF(x) (x)
+#define SEARCH_LESS(a, b) ((a) < (b))
+
+/* Поисков в группе пакетной версии */
+#define SEARCH_BATCH_GROUP 16
+
+/*
+ * SEARCH_DEF(dtype, ktype, dname, key_of, less) генерирует семейство поисков
+ * по массиву dtype, отсортированному по ключу key_of(элемент) типа ktype:
+ *   dname_lower_bound / dname_upper_bound / dname_equal_range
+ *   dname_lower_bound_batch / dname_upper_bound_batch
+ * key_of и less — макросы или inline-функции, они подставляются в тело поиска
+ * (в отличие от указателя на функцию в bsearch).
+ */
+#define SEARCH_DEF(dtype, ktype, dname, key_of, less)                               \
+                                                                                    \
+/* Первый элемент с ключом >= key (size, если такого нет) */                        \
+static inline size_t dname##_lower_bound(const dtype *arr, size_t size, ktype key) {\
+    if (size == 0) return 0;                                                        \
+    const dtype *base = arr;                                                        \
+    size_t len = size;                                                              \
+    while (len > 1) {                                                               \
+        size_t half = len / 2;                                                      \
+        base = less(key_of(base[half - 1]), key) ? base + half : base;              \
+        len -= half;                                                                \
+    }                                                                               \
+    return (size_t)(base - arr) + less(key_of(*base), key);                         \
+}                                                                                   \
+                                                                                    \
+/* Первый элемент с ключом > key (size, если такого нет) */                         \
+static inline size_t dname##_upper_bound(const dtype *arr, size_t size, ktype key) {\
+    if (size == 0) return 0;                                                        \
+    const dtype *base = arr;                                                        \
+    size_t len = size;                                                              \
+    while (len > 1) {                                                               \
+        size_t half = len / 2;                                                      \
+        base = less(key, key_of(base[half - 1])) ? base : base + half;              \
+        len -= half;                                                                \
+    }                                                                               \
+    return (size_t)(base - arr) + !less(key, key_of(*base));                        \
+}                                                                                   \
+                                                                                    \
+/* Полуинтервал [*first, *last) элементов с ключом key */                           \
+static inline void dname##_equal_range(const dtype *arr, size_t size, ktype key,    \
+                                       size_t *first, size_t *last) {               \
+    size_t lo = dname##_lower_bound(arr, size, key);                                \
+    *first = lo;                                                                    \
+    *last = lo + dname##_upper_bound(arr + lo, size - lo, key);                     \
+}                                                                                   \
+                                                                                    \
+/* Пакетные версии: группа поисков шагает в ногу, prefetch следующих пробников */  \
+static inline void dname##_lower_bound_batch(const dtype *arr, size_t size,         \
+                                             const ktype *keys, size_t count,       \
+                                             size_t *out) {                         \
+    const dtype *base[SEARCH_BATCH_GROUP];                                          \
+    for (size_t start = 0; start < count; start += SEARCH_BATCH_GROUP) {            \
+        size_t group = count - start < SEARCH_BATCH_GROUP                           \
+                     ? count - start : SEARCH_BATCH_GROUP;                          \
+        const ktype *x = keys + start;                                              \
+        if (size == 0) {                                                            \
+            for (size_t j = 0; j < group; j++) out[start + j] = 0;                  \
+            continue;                                                               \
+        }                                                                           \
+        for (size_t j = 0; j < group; j++) base[j] = arr;                           \
+        size_t len = size;                                                          \
+        while (len > 1) {                                                           \
+            size_t half = len / 2;                                                  \
+            for (size_t j = 0; j < group; j++) {                                    \
+                const dtype *b = base[j];                                           \
+                b = less(key_of(b[half - 1]), x[j]) ? b + half : b;                 \
+                base[j] = b;                                                        \
+                /* Следующий шаг читает b[(len - half) / 2 - 1], если он будет */   \
+                if (len - half > 1) SEARCH_PREFETCH(b + (len - half) / 2 - 1);      \
+            }                                                                       \
+            len -= half;                                                            \
+        }                                                                           \
+        for (size_t j = 0; j < group; j++)                                          \
+            out[start + j] = (size_t)(base[j] - arr)                                \
+                           + less(key_of(*base[j]), x[j]);                          \
+    }                                                                               \
+}                                                                                   \
+                                                                                    \
+static inline void dname##_upper_bound_batch(const dtype *arr, size_t size,         \
+                                             const ktype *keys, size_t count,       \
+                                             size_t *out) {                         \
+    const dtype *base[SEARCH_BATCH_GROUP];                                          \
+    for (size_t start = 0; start < count; start += SEARCH_BATCH_GROUP) {            \
+        size_t group = count - start < SEARCH_BATCH_GROUP                           \
+                     ? count - start : SEARCH_BATCH_GROUP;                          \
+        const ktype *x = keys + start;                                              \
+        if (size == 0) {                                                            \
+            for (size_t j = 0; j < group; j++) out[start + j] = 0;                  \
+            continue;                                                               \
+        }                                                                           \
+        for (size_t j = 0; j < group; j++) base[j] = arr;                           \
+        size_t len = size;                                                          \
+        while (len > 1) {                                                           \
+            size_t half = len / 2;                                                  \
+            for (size_t j = 0; j < group; j++) {                                    \
+                const dtype *b = base[j];                                           \
+                b = less(x[j], key_of(b[half - 1])) ? b : b + half;                 \
+                base[j] = b;                                                        \
+                /* Следующий шаг читает b[(len - half) / 2 - 1], если он будет */   \
+                if (len - half > 1) SEARCH_PREFETCH(b + (len - half) / 2 - 1);      \
+            }                                                                       \
+            len -= half;                                                            \
+        }                                                                           \
+        for (size_t j = 0; j < group; j++)                                          \
+            out[start + j] = (size_t)(base[j] - arr)                                \
+                           + !less(x[j], key_of(*base[j]));                         \
+    }                                                                               \
+}                                                                                   \
+
+#endif
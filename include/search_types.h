@@ -0,0 +1,11 @@
+#ifndef SEARCH_TYPES
+#define SEARCH_TYPES
+
+#include <stdint.h>
+#include "search.h"
+
+SEARCH_DEF(int, int, isearch, SEARCH_KEY_SELF, SEARCH_LESS)
+SEARCH_DEF(int64_t, int64_t, i64search, SEARCH_KEY_SELF, SEARCH_LESS)
+SEARCH_DEF(uint64_t, uint64_t, u64search, SEARCH_KEY_SELF, SEARCH_LESS)
+
+#endif
@@ -0,0 +1,13 @@
+#ifndef SORTED_SETS
+#define SORTED_SETS
+
+/*
+ * Операции над множествами, заданными строго возрастающими массивами int.
+ * Результат пишется в out и тоже строго возрастает; возвращается его длина.
+ * Размер out: пересечение — min(na, nb), объединение — na + nb, разность — na.
+ */
+int sorted_intersect(const int a[], int na, const int b[], int nb, int out[]);
+int sorted_union(const int a[], int na, const int b[], int nb, int out[]);
+int sorted_difference(const int a[], int na, const int b[], int nb, int out[]);
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef STREE
+#define STREE
+
+#include <stddef.h>
+
+#define STREE_B 16          /* ключей в узле: 16 * sizeof(int) = одна кэш-линия */
+#define STREE_MAX_HEIGHT 10 /* хватает для любого размера int */
+
+/* Статическое B+-дерево (S-дерево) над отсортированным массивом int */
+typedef struct {
+    int *tree;                             /* слои подряд: листья, затем внутренние */
+    size_t offset[STREE_MAX_HEIGHT + 1];   /* начало каждого слоя в tree */
+    int height;
+    int size;
+} stree_t;
+
+stree_t *stree_build(const int arr[], int size);
+void stree_destroy(stree_t *t);
+
+int stree_lower_bound(const stree_t *t, int target);
+int stree_search(const stree_t *t, int target);
+
+#endif
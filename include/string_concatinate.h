@@ -0,0 +1,53 @@
+#ifndef STRING_CONCATINATE
+#define STRING_CONCATINATE
+
+#include <stddef.h>
+#include <string.h>
+
+#define CONCAT_OK        0
+#define CONCAT_OVERFLOW  1
+#define CONCAT_BAD_FIRST 2
+#define CONCAT_ALLOC_ERR 3
+#define CONCAT_IO_ERR    4
+
+/* Кусок строки без завершающего нуля */
+typedef struct {
+    const char *ptr;
+    size_t len;
+} str_view_t;
+
+/*
+ * Строка, собираемая дописыванием кусков. Ёмкость задаётся заранее
+ * (str_builder_init / str_builder_reserve), при нехватке удваивается.
+ * Ошибка (переполнение или нехватка памяти) запоминается в status, и
+ * дальнейшие дописывания игнорируются до str_builder_finish.
+ */
+typedef struct {
+    char *buf;
+    size_t len;
+    size_t cap;
+    int status;
+} str_builder_t;
+
+int concat(char **result, char *first, ...);
+int concat_views(char **result, const str_view_t *parts, size_t count);
+
+int str_builder_init(str_builder_t *sb, size_t capacity);
+int str_builder_reserve(str_builder_t *sb, size_t extra);
+int str_builder_finish(str_builder_t *sb, char **result);
+void str_builder_free(str_builder_t *sb);
+
+static inline void str_builder_append(str_builder_t *sb, const char *ptr, size_t len)
+{
+    if (len > sb->cap - sb->len && str_builder_reserve(sb, len) != CONCAT_OK)
+        return;
+    memcpy(sb->buf + sb->len, ptr, len);
+    sb->len += len;
+}
+
+static inline void str_builder_append_view(str_builder_t *sb, str_view_t view)
+{
+    str_builder_append(sb, view.ptr, view.len);
+}
+
+#endif
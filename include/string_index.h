@@ -0,0 +1,28 @@
+#ifndef STRING_INDEX
+#define STRING_INDEX
+
+#include <stddef.h>
+
+#define STRING_INDEX_BLOCK 16 /* строк в блоке front coding */
+
+/*
+ * Словарь отсортированных строк со сжатием общих префиксов (front coding).
+ * Строки делятся на блоки по STRING_INDEX_BLOCK: первая строка блока
+ * хранится целиком, остальные — как (длина общего префикса с предыдущей,
+ * суффикс). Первые строки блоков доступны через массив heads.
+ */
+typedef struct {
+    unsigned char *data;   /* закодированные блоки */
+    size_t *block_offset;  /* начало каждого блока в data */
+    const char **heads;    /* указатели на первые (несжатые) строки блоков */
+    size_t count;
+    size_t block_count;
+} string_index_t;
+
+string_index_t *string_index_build(const char *const strs[], size_t count);
+void string_index_destroy(string_index_t *si);
+
+long string_index_search(const string_index_t *si, const char *key);
+size_t string_index_get(const string_index_t *si, size_t i, char *buf, size_t buf_size);
+
+#endif
@@ -0,0 +1,148 @@
+/**
+ * base_convert.c
+ *
+ * Массовый перевод чисел между системами счисления
+ *
+ * Вход отображается в память (mmap, MADV_SEQUENTIAL) и читается без
+ * копирования. Границы числа находит base_span, само число разбирает
+ * parse_base (оба по 8 символов за шаг), результат пишет format_base
+ * прямо в выходной буфер на 1 МиБ, который сбрасывается одним write.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "base_convert.h"
+#include "horners_schema.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define OUT_BUFFER_SIZE (1 << 20)
+#define MAX_DIGITS 65   /* 64 двоичные цифры и завершающий ноль */
+
+typedef struct {
+    int fd;
+    char *buf;
+    size_t used;
+} out_buffer_t;
+
+static int write_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return BASE_WRITE_ERROR;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+    return BASE_OK;
+}
+
+static int out_flush(out_buffer_t *out) {
+    int status = write_all(out->fd, out->buf, out->used);
+    out->used = 0;
+    return status;
+}
+
+static int out_append(out_buffer_t *out, const char *data, size_t len) {
+    while (len > 0) {
+        if (out->used == OUT_BUFFER_SIZE) {
+            int status = out_flush(out);
+            if (status != BASE_OK) return status;
+        }
+        size_t n = OUT_BUFFER_SIZE - out->used;
+        if (n > len) n = len;
+        memcpy(out->buf + out->used, data, n);
+        out->used += n;
+        data += n;
+        len -= n;
+    }
+    return BASE_OK;
+}
+
+static inline int is_number_char(unsigned char c) {
+    return (c >= '0' && c <= '9') || ((c | 0x20) >= 'a' && (c | 0x20) <= 'z');
+}
+
+int base_convert_buffer(const char *data, size_t len, int from_base, int to_base, int fd,
+                        base_convert_stats_t *stats) {
+    if (from_base < 2 || from_base > 36 || to_base < 2 || to_base > 36) return BASE_BAD_BASE;
+
+    out_buffer_t out = { fd, malloc(OUT_BUFFER_SIZE), 0 };
+    if (!out.buf) return BASE_NO_MEMORY;
+
+    size_t numbers = 0;
+    size_t i = 0;
+    int status = BASE_OK;
+    while (i < len && status == BASE_OK) {
+        // Разделители между числами копируются как есть
+        size_t start = i;
+        while (i < len && !is_number_char((unsigned char)data[i])) i++;
+        if (i > start) status = out_append(&out, data + start, i - start);
+        if (i == len || status != BASE_OK) break;
+
+        // Число целиком (все буквы и цифры подряд), затем проверка под from_base
+        size_t n = base_span(data + i, len - i, 36);
+        uint64_t value;
+        status = parse_base(data + i, n, from_base, &value);
+        if (status != BASE_OK) {
+            if (stats) stats->error_offset = i;
+            break;
+        }
+        if (OUT_BUFFER_SIZE - out.used < MAX_DIGITS && (status = out_flush(&out)) != BASE_OK) break;
+        size_t written;
+        format_base(value, to_base, out.buf + out.used, MAX_DIGITS, &written);
+        out.used += written;
+        numbers++;
+        i += n;
+    }
+    if (out.used > 0) {
+        int flushed = out_flush(&out);
+        if (status == BASE_OK) status = flushed;
+    }
+    free(out.buf);
+    if (stats) stats->numbers = numbers;
+    return status;
+}
+
+int base_convert_file(const char *path, int from_base, int to_base, int fd,
+                      base_convert_stats_t *stats) {
+    int in = open(path, O_RDONLY);
+    if (in < 0) return BASE_IO_ERROR;
+
+    // close и munmap не должны затереть errno ошибки, о которой сообщаем
+    struct stat st;
+    if (fstat(in, &st) != 0) {
+        int saved = errno;
+        close(in);
+        errno = saved;
+        return BASE_IO_ERROR;
+    }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(in);
+        return base_convert_buffer("", 0, from_base, to_base, fd, stats);
+    }
+
+    void *p = mmap(NULL, size, PROT_READ, MAP_PRIVATE, in, 0);
+    int saved = errno;
+    close(in);
+    if (p == MAP_FAILED) {
+        errno = saved;
+        return BASE_IO_ERROR;
+    }
+    // Проход строго последовательный — просим ядро читать вперёд крупно
+    madvise(p, size, MADV_SEQUENTIAL);
+
+    int status = base_convert_buffer(p, size, from_base, to_base, fd, stats);
+    saved = errno;
+    munmap(p, size);
+    errno = saved;
+    return status;
+}
@@ -0,0 +1,661 @@
+/**
+ * bignum_base.c
+ *
+ * Перевод длинных чисел между строкой в системе base (2..36) и двоичным
+ * представлением за субквадратичное время
+ *
+ * Строка режется на куски по k цифр, где B = base^k — наибольшая степень,
+ * помещающаяся в 64 бита, и заранее считаются степени B^(2^j) (возведением
+ * в квадрат).
+ * Разбор: листья — куски по k цифр (parse_base); на уровне j соседние узлы
+ *   склеиваются как hi * B^(2^j) + lo. Узел уровня j меньше B^(2^j) и
+ *   помещается ровно в 2^j слов, поэтому уровень хранится плотным массивом.
+ * Печать: число N < B^(2^(j+1)) делится с остатком на B^(2^j), частное и
+ *   остаток печатаются рекурсивно в левую и правую половины поля ширины
+ *   k * 2^(j+1) (остаток — с ведущими нулями). Деление — умножением на
+ *   обратную величину R = floor(2^(128m) / P), посчитанную методом Ньютона
+ *   (от обратной к старшей половине P со словом запаса один шаг удваивает
+ *   точность, остаток ошибки доводится до точной R); частное досчитывается
+ *   парой вычитаний.
+ * Умножение — Карацуба от KARATSUBA_THRESHOLD слов, так что обе стороны
+ * стоят O(M(n) log n) вместо O(n^2). Небольшие узлы (до BASECASE_LIMBS слов
+ * в делителе) печатаются обычным делением на B по одному слову.
+ *
+ * Тестовый main — под макросом BIGNUM_BASE_TEST.
+ */
+
+#include "bignum_base.h"
+#include "horners_schema.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define KARATSUBA_THRESHOLD 32
+#define BASECASE_LIMBS 16
+#define MAX_LEVELS 64
+/*
+ * Доводка обратной величины и частного: при верной оценке хватает единиц
+ * шагов. Худший случай обратной — m = 2, где запасного слова нет (h = 1):
+ * ошибка до 2^129 (2^-63)^2 = 8 единиц плюс округления.
+ */
+#define RECIP_MAX_FIXUPS 16
+#define DIVMOD_MAX_FIXUPS 4
+
+typedef unsigned __int128 u128;
+
+/* Степень B^(2^j) и, для печати, нормализованный делитель с обратной величиной */
+typedef struct {
+    uint64_t *limb;
+    size_t size;
+    unsigned shift;     /* сдвиг, после которого старший бит делителя — единица */
+    uint64_t *norm;     /* limb << shift, size слов */
+    uint64_t *recip;    /* floor(2^(128 size) / norm), size + 1 слов */
+} base_power_t;
+
+static size_t limbs_norm(const uint64_t *a, size_t n) {
+    while (n > 0 && a[n - 1] == 0) n--;
+    return n;
+}
+
+static int limbs_cmp(const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    an = limbs_norm(a, an);
+    bn = limbs_norm(b, bn);
+    if (an != bn) return an < bn ? -1 : 1;
+    while (an-- > 0) {
+        if (a[an] != b[an]) return a[an] < b[an] ? -1 : 1;
+    }
+    return 0;
+}
+
+/* r = a + b (an >= bn, r может совпадать с a), возвращает перенос */
+static uint64_t limbs_add(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    uint64_t carry = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        u128 s = (u128)a[i] + b[i] + carry;
+        r[i] = (uint64_t)s;
+        carry = (uint64_t)(s >> 64);
+    }
+    for (; i < an; i++) {
+        uint64_t s = a[i] + carry;
+        carry = s < carry;
+        r[i] = s;
+    }
+    return carry;
+}
+
+/* r = a - b (an >= bn, r может совпадать с a), возвращает заём */
+static uint64_t limbs_sub(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    uint64_t borrow = 0;
+    size_t i = 0;
+    for (; i < bn; i++) {
+        uint64_t d = a[i] - b[i];
+        uint64_t nb = (a[i] < b[i]) | (d < borrow);
+        r[i] = d - borrow;
+        borrow = nb;
+    }
+    for (; i < an; i++) {
+        uint64_t d = a[i] - borrow;
+        borrow = a[i] < borrow;
+        r[i] = d;
+    }
+    return borrow;
+}
+
+static void limbs_add_1(uint64_t *a, size_t n, uint64_t v) {
+    for (size_t i = 0; i < n && v; i++) {
+        a[i] += v;
+        v = a[i] < v;
+    }
+}
+
+/* r[an + bn] = a * b школьным методом; r не пересекается с a и b */
+static void mul_basecase(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    memset(r, 0, sizeof(uint64_t) * (an + bn));
+    for (size_t i = 0; i < an; i++) {
+        uint64_t carry = 0;
+        for (size_t j = 0; j < bn; j++) {
+            u128 t = (u128)a[i] * b[j] + r[i + j] + carry;
+            r[i + j] = (uint64_t)t;
+            carry = (uint64_t)(t >> 64);
+        }
+        r[i + bn] = carry;
+    }
+}
+
+/* Черновая память для mul_karatsuba(n): с запасом на все уровни рекурсии */
+static size_t karatsuba_scratch(size_t n) {
+    return 4 * n + 1024;
+}
+
+/*
+ * r[2n] = a[n] * b[n]: z0 = a0 b0, z2 = a1 b1, z1 = (a0 + a1)(b0 + b1) - z0 - z2,
+ * три умножения половинной длины вместо четырёх
+ */
+static void mul_karatsuba(uint64_t *r, const uint64_t *a, const uint64_t *b, size_t n, uint64_t *scratch) {
+    if (n < KARATSUBA_THRESHOLD) {
+        mul_basecase(r, a, n, b, n);
+        return;
+    }
+    size_t h = n / 2;
+    size_t hn = n - h;
+    uint64_t *sa = scratch;
+    uint64_t *sb = sa + hn + 1;
+    uint64_t *z1 = sb + hn + 1;
+    uint64_t *next = z1 + 2 * (hn + 1);
+
+    mul_karatsuba(r, a, b, h, next);
+    mul_karatsuba(r + 2 * h, a + h, b + h, hn, next);
+
+    sa[hn] = limbs_add(sa, a + h, hn, a, h);
+    sb[hn] = limbs_add(sb, b + h, hn, b, h);
+    mul_karatsuba(z1, sa, sb, hn + 1, next);
+    limbs_sub(z1, z1, 2 * (hn + 1), r, 2 * h);
+    limbs_sub(z1, z1, 2 * (hn + 1), r + 2 * h, 2 * hn);
+    limbs_add(r + h, r + h, 2 * n - h, z1, limbs_norm(z1, 2 * (hn + 1)));
+}
+
+/* r[an + bn] = a * b; r не пересекается с a и b. 0 или -1 при нехватке памяти */
+static int limbs_mul(uint64_t *r, const uint64_t *a, size_t an, const uint64_t *b, size_t bn) {
+    if (an < bn) {
+        const uint64_t *t = a;
+        a = b;
+        b = t;
+        size_t tn = an;
+        an = bn;
+        bn = tn;
+    }
+    if (bn < KARATSUBA_THRESHOLD) {
+        if (bn == 0) {
+            memset(r, 0, sizeof(uint64_t) * an);
+        } else {
+            mul_basecase(r, a, an, b, bn);
+        }
+        return 0;
+    }
+
+    // Длинное a режется на куски по bn слов; каждый кусок — Карацуба с b
+    uint64_t *tmp = malloc(sizeof(uint64_t) * (2 * bn + karatsuba_scratch(bn)));
+    if (!tmp) return -1;
+    uint64_t *scratch = tmp + 2 * bn;
+    memset(r, 0, sizeof(uint64_t) * (an + bn));
+    int status = 0;
+    for (size_t off = 0; off < an; off += bn) {
+        size_t cn = an - off < bn ? an - off : bn;
+        if (cn == bn) {
+            mul_karatsuba(tmp, a + off, b, bn, scratch);
+        } else if (limbs_mul(tmp, b, bn, a + off, cn) != 0) {
+            status = -1;
+            break;
+        }
+        limbs_add(r + off, r + off, an + bn - off, tmp, cn + bn);
+    }
+    free(tmp);
+    return status;
+}
+
+/* r[n + 1] = a[n] << sh, 0 <= sh < 64 */
+static void limbs_shl(uint64_t *r, const uint64_t *a, size_t n, unsigned sh) {
+    if (sh == 0) {
+        memcpy(r, a, sizeof(uint64_t) * n);
+        r[n] = 0;
+        return;
+    }
+    uint64_t prev = 0;
+    for (size_t i = 0; i < n; i++) {
+        r[i] = (a[i] << sh) | prev;
+        prev = a[i] >> (64 - sh);
+    }
+    r[n] = prev;
+}
+
+static void limbs_shr(uint64_t *a, size_t n, unsigned sh) {
+    if (sh == 0) return;
+    for (size_t i = 0; i < n; i++) {
+        a[i] = (a[i] >> sh) | (i + 1 < n ? a[i + 1] << (64 - sh) : 0);
+    }
+}
+
+/*
+ * Доводит r[m + 1] ~ floor(2^(128m) / p) до точного значения: e = p r
+ * сравнивается с 2^(128m), r сдвигается на единицу за шаг. e[2m + 1] и
+ * f[2m + 1] — черновая память.
+ */
+static int reciprocal_fixup(uint64_t *r, const uint64_t *p, size_t m, uint64_t *e, uint64_t *f) {
+    size_t s = 2 * m;
+    uint64_t one = 1;
+    if (limbs_mul(e, p, m, r, m + 1) != 0) return -1;
+    int steps = 0;
+    // e > 2^s: r велика
+    while (e[s] > 1 || (e[s] == 1 && limbs_norm(e, s) != 0)) {
+        if (++steps > RECIP_MAX_FIXUPS) return -1;
+        limbs_sub(r, r, m + 1, &one, 1);
+        limbs_sub(e, e, s + 1, p, m);
+    }
+    // e + p <= 2^s: r мала
+    for (;;) {
+        f[s] = e[s] + limbs_add(f, e, s, p, m);
+        if (f[s] > 1 || (f[s] == 1 && limbs_norm(f, s) != 0)) break;
+        if (++steps > RECIP_MAX_FIXUPS) return -1;
+        limbs_add_1(r, m + 1, 1);
+        memcpy(e, f, sizeof(uint64_t) * (s + 1));
+    }
+    return 0;
+}
+
+/*
+ * r[m + 1] = floor(2^(128m) / p), p[m] нормализовано (старший бит единица).
+ * Обратная к старшим h > m / 2 словам (с запасным словом) даёт приближение
+ * X0 с относительной ошибкой O(2^(-64h)); шаг Ньютона
+ * X1 = X0 + X0 (2^s - p X0) / 2^s возводит её в квадрат, так что X1 отличается
+ * от точной на единицы, и reciprocal_fixup доводит её. Без запасного слова
+ * (h = m / 2) ошибка после шага — уже сотни единиц, и на каждом уровне
+ * рекурсии она возводится в квадрат.
+ */
+static int reciprocal(uint64_t *r, const uint64_t *p, size_t m) {
+    if (m == 1) {
+        u128 q = ~(u128)0 / p[0];
+        if (~(u128)0 % p[0] + 1 == p[0]) q++;
+        r[0] = (uint64_t)q;
+        r[1] = (uint64_t)(q >> 64);
+        return 0;
+    }
+    size_t h = m == 2 ? 1 : m / 2 + 1;
+    size_t l = m - h;
+    size_t s = 2 * m;  /* 2^(128m) — это единица в слове s */
+
+    // x0[m + 1] | d[2m + 1] | t[(m + 1) + (2m + 1)]
+    uint64_t *buf = calloc((m + 1) + (2 * m + 1) + (3 * m + 2), sizeof(uint64_t));
+    if (!buf) return -1;
+    uint64_t *x0 = buf;
+    uint64_t *d = x0 + m + 1;
+    uint64_t *t = d + 2 * m + 1;
+
+    int status = reciprocal(x0 + l, p + l, h);
+    if (status == 0) status = limbs_mul(d, p, m, x0, m + 1);
+    if (status == 0) {
+        int above = d[s] != 0;
+        if (above) {
+            d[s] -= 1;                      // d = p x0 - 2^s
+        } else {
+            for (size_t i = 0; i < s; i++) d[i] = ~d[i];
+            limbs_add_1(d, s, 1);           // d = 2^s - p x0
+        }
+        size_t dn = limbs_norm(d, s + 1);
+        memset(r, 0, sizeof(uint64_t) * (m + 1));
+        if (dn == 0) {
+            memcpy(r, x0, sizeof(uint64_t) * (m + 1));
+        } else {
+            status = limbs_mul(t, x0, m + 1, d, dn);
+        }
+        if (status == 0 && dn != 0) {
+            // Поправка — слова t начиная с s (t обнулён, так что хотя бы одно слово есть)
+            uint64_t *corr = t + s;
+            size_t tn = m + 1 + dn;
+            size_t cn = tn > s ? tn - s : 1;
+            if (above) {
+                limbs_sub(r, x0, m + 1, corr, limbs_norm(corr, cn));
+            } else {
+                limbs_add(r, x0, m + 1, corr, limbs_norm(corr, cn));
+            }
+        }
+    }
+    // d и t больше не нужны — черновая память для доводки
+    if (status == 0) status = reciprocal_fixup(r, p, m, d, t);
+    free(buf);
+    return status;
+}
+
+/*
+ * q[m + 1], r[m] — частное и остаток от деления a[an] на степень pw, если
+ * a < pw^2. Для оценки частного хватает старших m + 1 слов a' = a << shift:
+ * при точной R floor(a'_hi R / 2^(64(m+1))) не больше точного и меньше его
+ * не более чем на 2; недостачу добирает цикл вычитаний.
+ */
+static int divmod_power(uint64_t *q, uint64_t *r, const uint64_t *a, size_t an, const base_power_t *pw) {
+    size_t m = pw->size;
+    uint64_t *buf = calloc((2 * m + 1) + (2 * m + 2) + (2 * m + 1), sizeof(uint64_t));
+    if (!buf) return -1;
+    uint64_t *na = buf;
+    uint64_t *prod = na + 2 * m + 1;
+    uint64_t *qp = prod + 2 * m + 2;
+
+    limbs_shl(na, a, an, pw->shift);
+    int status = limbs_mul(prod, na + m - 1, m + 1, pw->recip, m + 1);
+    if (status == 0) {
+        memcpy(q, prod + m + 1, sizeof(uint64_t) * (m + 1));
+        status = limbs_mul(qp, q, m + 1, pw->norm, m);
+    }
+    if (status == 0) {
+        limbs_sub(na, na, 2 * m + 1, qp, 2 * m + 1);
+        int steps = 0;
+        while (limbs_cmp(na, 2 * m + 1, pw->norm, m) >= 0) {
+            // Больше пары шагов — R неточна; не уходим в O(ошибка * m)
+            if (++steps > DIVMOD_MAX_FIXUPS) {
+                status = -1;
+                break;
+            }
+            limbs_sub(na, na, 2 * m + 1, pw->norm, m);
+            limbs_add_1(q, m + 1, 1);
+        }
+    }
+    if (status == 0) {
+        limbs_shr(na, m, pw->shift);
+        memcpy(r, na, sizeof(uint64_t) * m);
+    }
+    free(buf);
+    return status;
+}
+
+/* Наибольшее k, при котором base^k помещается в 64 бита */
+static unsigned chunk_digits(int base, uint64_t *big) {
+    uint64_t b = (uint64_t)base;
+    uint64_t p = b;
+    unsigned k = 1;
+    while (p <= UINT64_MAX / b) {
+        p *= b;
+        k++;
+    }
+    *big = p;
+    return k;
+}
+
+static void powers_free(base_power_t *pw, size_t levels) {
+    for (size_t j = 0; j < levels; j++) {
+        free(pw[j].limb);
+        free(pw[j].norm);
+        free(pw[j].recip);
+    }
+}
+
+/* pw[j] = B^(2^j): B для j = 0, иначе квадрат pw[j - 1] */
+static int power_next(base_power_t *pw, size_t j, uint64_t big) {
+    memset(&pw[j], 0, sizeof(base_power_t));
+    size_t n = j == 0 ? 1 : 2 * pw[j - 1].size;
+    pw[j].limb = malloc(sizeof(uint64_t) * n);
+    if (!pw[j].limb) return -1;
+    if (j == 0) {
+        pw[j].limb[0] = big;
+    } else if (limbs_mul(pw[j].limb, pw[j - 1].limb, pw[j - 1].size, pw[j - 1].limb, pw[j - 1].size) != 0) {
+        return -1;
+    }
+    pw[j].size = limbs_norm(pw[j].limb, n);
+    return 0;
+}
+
+/* Делитель и обратная величина для печати через pw */
+static int power_prepare_division(base_power_t *pw) {
+    size_t m = pw->size;
+    pw->shift = (unsigned)__builtin_clzll(pw->limb[m - 1]);
+    pw->norm = malloc(sizeof(uint64_t) * (m + 1));
+    pw->recip = calloc(m + 1, sizeof(uint64_t));
+    if (!pw->norm || !pw->recip) return -1;
+    limbs_shl(pw->norm, pw->limb, m, pw->shift);
+    return reciprocal(pw->recip, pw->norm, m);
+}
+
+int bignum_parse(const char *str, size_t len, int base, bignum_t *out) {
+    if (base < 2 || base > 36) return BASE_BAD_BASE;
+    if (len == 0) return BASE_BAD_DIGIT;
+
+    uint64_t big;
+    unsigned k = chunk_digits(base, &big);
+    size_t chunks = (len + k - 1) / k;
+    size_t width = 1;
+    size_t levels = 0;
+    while (width < chunks) {
+        width *= 2;
+        levels++;
+    }
+
+    uint64_t *a = calloc(2 * width, sizeof(uint64_t));
+    if (!a) return BASE_NO_MEMORY;
+    uint64_t *b = a + width;
+
+    // Листья: кусок i — цифры, отстоящие от конца строки на [i k, (i + 1) k)
+    for (size_t i = 0; i < chunks; i++) {
+        size_t end = len - i * k;
+        size_t start = end > k ? end - k : 0;
+        if (parse_base(str + start, end - start, base, &a[i]) != BASE_OK) {
+            free(a);
+            return BASE_BAD_DIGIT;
+        }
+    }
+
+    base_power_t pw[MAX_LEVELS];
+    size_t built = 0;
+    int status = BASE_OK;
+    while (built < levels && status == BASE_OK) {
+        if (power_next(pw, built++, big) != 0) status = BASE_NO_MEMORY;
+    }
+    for (size_t j = 0; j < levels && status == BASE_OK; j++) {
+        size_t s = (size_t)1 << j;
+        for (size_t off = 0; off < width; off += 2 * s) {
+            const uint64_t *lo = a + off;
+            const uint64_t *hi = a + off + s;
+            uint64_t *dst = b + off;
+            size_t hn = limbs_norm(hi, s);
+            if (hn == 0) {
+                memcpy(dst, lo, sizeof(uint64_t) * s);
+                memset(dst + s, 0, sizeof(uint64_t) * s);
+                continue;
+            }
+            if (limbs_mul(dst, hi, hn, pw[j].limb, pw[j].size) != 0) {
+                status = BASE_NO_MEMORY;
+                break;
+            }
+            size_t used = hn + pw[j].size;
+            memset(dst + used, 0, sizeof(uint64_t) * (2 * s - used));
+            limbs_add(dst, dst, 2 * s, lo, s);
+        }
+        uint64_t *t = a;
+        a = b;
+        b = t;
+    }
+    powers_free(pw, built);
+
+    if (status != BASE_OK) {
+        free(a < b ? a : b);
+        return status;
+    }
+    // a и b — половины одного блока; результат переносим в начало
+    uint64_t *block = a < b ? a : b;
+    size_t n = limbs_norm(a, width);
+    memmove(block, a, sizeof(uint64_t) * n);
+    uint64_t *shrunk = realloc(block, sizeof(uint64_t) * (n ? n : 1));
+    out->limb = shrunk ? shrunk : block;
+    out->size = n;
+    return BASE_OK;
+}
+
+/* Ровно k цифр v (v < B) с ведущими нулями */
+static void write_chunk(uint64_t v, int base, unsigned k, char *out) {
+    char tmp[72];
+    size_t n;
+    format_base(v, base, tmp, sizeof(tmp), &n);
+    memset(out, '0', k - n);
+    memcpy(out + k - n, tmp, n);
+}
+
+/* Печать a < B^(2^(j+1)) ровно в k 2^(j+1) цифр делением на B по слову */
+static int format_basecase(const uint64_t *a, size_t an, size_t j, int base, unsigned k, uint64_t big, char *out) {
+    uint64_t local[2 * BASECASE_LIMBS];
+    memcpy(local, a, sizeof(uint64_t) * an);
+    size_t chunks = (size_t)2 << j;
+    for (size_t c = chunks; c-- > 0;) {
+        uint64_t rem = 0;
+        for (size_t i = an; i-- > 0;) {
+            u128 cur = ((u128)rem << 64) | local[i];
+            local[i] = (uint64_t)(cur / big);
+            rem = (uint64_t)(cur % big);
+        }
+        an = limbs_norm(local, an);
+        write_chunk(rem, base, k, out + c * k);
+    }
+    return 0;
+}
+
+/* Печать a < (pw[j])^2 ровно в k 2^(j+1) цифр */
+static int format_level(const uint64_t *a, size_t an, size_t j, base_power_t *pw,
+                        int base, unsigned k, uint64_t big, char *out) {
+    an = limbs_norm(a, an);
+    if (pw[j].size <= BASECASE_LIMBS) return format_basecase(a, an, j, base, k, big, out);
+
+    size_t m = pw[j].size;
+    uint64_t *q = malloc(sizeof(uint64_t) * (2 * m + 1));
+    if (!q) return -1;
+    uint64_t *r = q + m + 1;
+    size_t half = k << j;
+    int status = divmod_power(q, r, a, an, &pw[j]);
+    if (status == 0) status = format_level(q, m, j - 1, pw, base, k, big, out);
+    if (status == 0) status = format_level(r, m, j - 1, pw, base, k, big, out + half);
+    free(q);
+    return status;
+}
+
+char *bignum_format(const bignum_t *num, int base, size_t *len) {
+    if (base < 2 || base > 36) return NULL;
+    size_t n = limbs_norm(num->limb, num->size);
+
+    uint64_t big;
+    unsigned k = chunk_digits(base, &big);
+
+    // Наименьшее t с B^(2^t) > num; печатаем в поле k 2^t цифр
+    base_power_t pw[MAX_LEVELS];
+    size_t levels = 0;
+    int failed = 0;
+    for (;;) {
+        failed = power_next(pw, levels, big) != 0;
+        levels++;
+        if (failed || limbs_cmp(pw[levels - 1].limb, pw[levels - 1].size, num->limb, n) > 0) break;
+    }
+
+    char *str = NULL;
+    size_t top = levels - 1;   /* num < pw[top] = pw[top - 1]^2 */
+    size_t width = (size_t)k << top;
+    for (size_t j = 0; j + 1 < levels && !failed; j++) {
+        if (pw[j].size > BASECASE_LIMBS && power_prepare_division(&pw[j]) != 0) failed = 1;
+    }
+    if (!failed) str = malloc(width + 1);
+    if (str) {
+        int status = top == 0 ? (write_chunk(n ? num->limb[0] : 0, base, k, str), 0)
+                              : format_level(num->limb, n, top - 1, pw, base, k, big, str);
+        if (status != 0) {
+            free(str);
+            str = NULL;
+        } else {
+            // Поле было с запасом — убираем ведущие нули (одну цифру оставляем)
+            size_t skip = 0;
+            while (skip + 1 < width && str[skip] == '0') skip++;
+            memmove(str, str + skip, width - skip);
+            str[width - skip] = '\0';
+            if (len) *len = width - skip;
+        }
+    }
+    powers_free(pw, levels);
+    return str;
+}
+
+void bignum_free(bignum_t *num) {
+    if (!num) return;
+    free(num->limb);
+    num->limb = NULL;
+    num->size = 0;
+}
+
+#ifdef BIGNUM_BASE_TEST
+#include <stdio.h>
+
+static uint64_t test_state = 88172645463325252ULL;
+
+static uint64_t test_random(void) {
+    test_state ^= test_state << 13;
+    test_state ^= test_state >> 7;
+    test_state ^= test_state << 17;
+    return test_state;
+}
+
+/* Эталон floor(2^(128m) / p) делением «уголком» по одному биту */
+static void reciprocal_reference(uint64_t *q, const uint64_t *p, size_t m) {
+    uint64_t *rem = calloc(m + 1, sizeof(uint64_t));
+    memset(q, 0, sizeof(uint64_t) * (m + 1));
+    for (size_t bit = 128 * m + 1; bit-- > 0;) {
+        uint64_t carry = bit == 128 * m;
+        for (size_t i = 0; i <= m; i++) {
+            uint64_t top = rem[i] >> 63;
+            rem[i] = (rem[i] << 1) | carry;
+            carry = top;
+        }
+        if (limbs_cmp(rem, m + 1, p, m) >= 0) {
+            limbs_sub(rem, rem, m + 1, p, m);
+            if (bit < 64 * (m + 1)) q[bit / 64] |= (uint64_t)1 << (bit % 64);
+        }
+    }
+    free(rem);
+}
+
+int main(void) {
+    static const size_t sizes[] = { 1, 2, 3, 4, 5, 7, 8, 16, 17, 31, 32, 33, 64, 65 };
+    int failed = 0;
+    for (size_t si = 0; si < sizeof(sizes) / sizeof(sizes[0]); si++) {
+        size_t m = sizes[si];
+        uint64_t *p = malloc(sizeof(uint64_t) * m);
+        uint64_t *r = calloc(m + 1, sizeof(uint64_t));
+        uint64_t *ref = malloc(sizeof(uint64_t) * (m + 1));
+        for (int it = 0; it < 8; it++) {
+            // Случайные делители и крайние: 2^(64m - 1), все единицы, редкие слова
+            for (size_t i = 0; i < m; i++) {
+                p[i] = it == 0 ? 0 : it == 1 ? ~(uint64_t)0 : it == 2 ? (i % 2 ? ~(uint64_t)0 : 0) : test_random();
+            }
+            p[m - 1] |= (uint64_t)1 << 63;
+            reciprocal_reference(ref, p, m);
+            if (reciprocal(r, p, m) != 0 || memcmp(r, ref, sizeof(uint64_t) * (m + 1)) != 0) {
+                printf("reciprocal mismatch: m = %zu, case %d\n", m, it);
+                failed = 1;
+            }
+        }
+        free(p);
+        free(r);
+        free(ref);
+    }
+    printf("reciprocal vs exact division: %s\n", failed ? "FAIL" : "ok");
+
+    // Круговой перевод длинных чисел между парами оснований
+    static const size_t lengths[] = { 1, 40, 1000, 4166, 9000 };
+    static const char digits[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+    int round_trips = 0;
+    for (int from = 2; from <= 36; from++) {
+        for (int to = 2 + from % 3; to <= 36; to += 5) {
+            for (size_t li = 0; li < sizeof(lengths) / sizeof(lengths[0]); li++) {
+                size_t n = lengths[li];
+                char *s = malloc(n + 1);
+                for (size_t i = 0; i < n; i++) s[i] = digits[test_random() % (uint64_t)from];
+                if (n > 1) s[0] = digits[1 + test_random() % (uint64_t)(from - 1)];
+                s[n] = '\0';
+
+                bignum_t x, y;
+                size_t tn, bn;
+                char *t = NULL, *back = NULL;
+                int ok = bignum_parse(s, n, from, &x) == BASE_OK;
+                if (ok) ok = (t = bignum_format(&x, to, &tn)) != NULL;
+                if (ok) ok = bignum_parse(t, tn, to, &y) == BASE_OK;
+                if (ok) {
+                    back = bignum_format(&y, from, &bn);
+                    ok = back && bn == n && memcmp(back, s, n) == 0;
+                    bignum_free(&y);
+                }
+                if (!ok) {
+                    printf("round trip mismatch: %zu digits, base %d -> %d\n", n, from, to);
+                    failed = 1;
+                }
+                bignum_free(&x);
+                free(s);
+                free(t);
+                free(back);
+                round_trips++;
+            }
+        }
+    }
+    printf("%d round trips: %s\n", round_trips, failed ? "FAIL" : "ok");
+    return failed;
+}
+#endif /* BIGNUM_BASE_TEST */
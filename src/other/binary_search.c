@@ -1,5 +1,7 @@
+#include "binary_search.h"
+
 // Бинарный поиск в отсортированном массиве целых чисел
-int binary_search(int arr[], int size, int target) {
+int binary_search(const int arr[], int size, int target) {
     int left = 0;
     int right = size - 1;
     while (left <= right) {
@@ -13,4 +15,55 @@ int binary_search(int arr[], int size, int target) {
         }
     }
     return -1; // Не нашли
-}
\ No newline at end of file
+}
+
+/* Сколько поисков продвигается одновременно: столько промахов кэша перекрываются */
+#define BATCH_GROUP 16
+
+#if defined(__GNUC__)
+#define BATCH_PREFETCH(p) __builtin_prefetch(p)
+#else
+#define BATCH_PREFETCH(p) ((void)0)
+#endif
+
+/*
+ * Пакетный бинарный поиск: out[i] — индекс targets[i] в arr или -1.
+ * Поиски идут группами по BATCH_GROUP в ногу (AMAC-подобное чередование):
+ * на каждом шаге все поиски группы делают по одному сравнению и запрашивают
+ * prefetch своего следующего пробника, так что обращения к памяти
+ * разных поисков выполняются параллельно, а не друг за другом.
+ */
+void binary_search_batch(const int arr[], int size, const int targets[], int count, int out[]) {
+    const int *base[BATCH_GROUP];
+
+    for (int start = 0; start < count; start += BATCH_GROUP) {
+        int group = count - start < BATCH_GROUP ? count - start : BATCH_GROUP;
+        const int *x = targets + start;
+
+        if (size <= 0) {
+            for (int j = 0; j < group; j++) out[start + j] = -1;
+            continue;
+        }
+
+        for (int j = 0; j < group; j++) base[j] = arr;
+
+        // Все поиски группы имеют одинаковую длину интервала — шагаем синхронно
+        int len = size;
+        while (len > 1) {
+            int half = len / 2;
+            for (int j = 0; j < group; j++) {
+                const int *b = base[j];
+                b = (b[half] < x[j]) ? b + half : b; // Компилируется в cmov
+                base[j] = b;
+                BATCH_PREFETCH(b + (len - half) / 2); // Пробник следующего шага
+            }
+            len -= half;
+        }
+
+        for (int j = 0; j < group; j++) {
+            const int *b = base[j];
+            int pos = (int)(b - arr) + (*b < x[j]);
+            out[start + j] = (pos < size && arr[pos] == x[j]) ? pos : -1;
+        }
+    }
+}
@@ -0,0 +1,106 @@
+/**
+ * cascade.c
+ *
+ * Дробный каскад (fractional cascading): поиск одного ключа в k массивах
+ *
+ * Вместо k независимых бинарных поисков строятся уровни M_0 .. M_{k-1}:
+ *   M_{k-1} = A_{k-1},  M_i = A_i, слитый с каждым вторым элементом M_{i+1}.
+ * Для каждого элемента уровня хранится его lower bound в A_i (a_pos) и на
+ * уровне M_{i+1} (bridge). Размер всех уровней — O(сумма размеров A_i).
+ *
+ * Поиск: один бинарный поиск в M_0 даёт позицию p первого элемента >= x.
+ *   - lower bound x в A_i равен a_pos[p]: элемент A_i из [x, M_i[p]) сам
+ *     попал бы в M_i раньше p;
+ *   - на уровне i + 1 ответ — bridge[p] или bridge[p] - 1: из двух соседних
+ *     элементов M_{i+1} хотя бы один есть в M_i, поэтому между x и M_i[p]
+ *     лежит не больше одного элемента M_{i+1}.
+ * Итого O(log n + k) вместо O(k log n).
+ */
+
+#include "cascade.h"
+#include "search_types.h"
+#include <stdlib.h>
+
+void cascade_destroy(cascade_t *c) {
+    if (!c) return;
+    if (c->levels) {
+        for (int i = 0; i < c->k; i++) {
+            free(c->levels[i].keys);
+            free(c->levels[i].a_pos);
+            free(c->levels[i].bridge);
+        }
+    }
+    free(c->levels);
+    free(c);
+}
+
+/* Строит уровень i из A_i и уже готового уровня next (или NULL для последнего) */
+static int cascade_build_level(cascade_level_t *lv, const int a[], int na, const cascade_level_t *next) {
+    int nsample = next ? next->size / 2 : 0;
+    lv->size = na + nsample;
+    // +1 — заглушка для x больше всех ключей уровня
+    lv->keys = malloc(sizeof(int) * ((size_t)lv->size + 1));
+    lv->a_pos = malloc(sizeof(int) * ((size_t)lv->size + 1));
+    lv->bridge = malloc(sizeof(int) * ((size_t)lv->size + 1));
+    if (!lv->keys || !lv->a_pos || !lv->bridge) return -1;
+
+    int i = 0, j = 0;   // A_i и выборка next: next->keys[2j + 1]
+    int ia = 0, inx = 0; // указатели для lower bound в A_i и в next
+    for (int m = 0; m < lv->size; m++) {
+        int key;
+        if (j >= nsample || (i < na && a[i] <= next->keys[2 * j + 1])) {
+            key = a[i++];
+        } else {
+            key = next->keys[2 * j + 1];
+            j++;
+        }
+        while (ia < na && a[ia] < key) ia++;
+        lv->keys[m] = key;
+        lv->a_pos[m] = ia;
+        if (next) {
+            while (inx < next->size && next->keys[inx] < key) inx++;
+            lv->bridge[m] = inx;
+        } else {
+            lv->bridge[m] = 0;
+        }
+    }
+    lv->keys[lv->size] = 0;
+    lv->a_pos[lv->size] = na;
+    lv->bridge[lv->size] = next ? next->size : 0;
+    return 0;
+}
+
+cascade_t *cascade_build(const int *const arrays[], const int sizes[], int k) {
+    if (k <= 0) return NULL;
+    cascade_t *c = malloc(sizeof(cascade_t));
+    if (!c) return NULL;
+    c->k = k;
+    c->levels = calloc((size_t)k, sizeof(cascade_level_t));
+    if (!c->levels) {
+        cascade_destroy(c);
+        return NULL;
+    }
+    for (int i = k - 1; i >= 0; i--) {
+        const cascade_level_t *next = i + 1 < k ? &c->levels[i + 1] : NULL;
+        if (cascade_build_level(&c->levels[i], arrays[i], sizes[i], next) != 0) {
+            cascade_destroy(c);
+            return NULL;
+        }
+    }
+    return c;
+}
+
+// out[i] — индекс первого элемента >= target в arrays[i] (sizes[i], если такого нет)
+void cascade_lower_bound(const cascade_t *c, int target, int out[]) {
+    const cascade_level_t *lv = &c->levels[0];
+    int p = (int)isearch_lower_bound(lv->keys, (size_t)lv->size, target);
+    for (int i = 0; i < c->k; i++) {
+        lv = &c->levels[i];
+        out[i] = lv->a_pos[p];
+        if (i + 1 < c->k) {
+            const cascade_level_t *next = &c->levels[i + 1];
+            p = lv->bridge[p];
+            if (p > 0 && next->keys[p - 1] >= target) p--;
+        }
+    }
+}
@@ -0,0 +1,113 @@
+/**
+ * eytzinger_search.c
+ *
+ * Бинарный поиск в раскладке Эйтцингера (Eytzinger / BFS layout)
+ *
+ * Отсортированный массив переставляется в порядок обхода в ширину неявного
+ * сбалансированного дерева поиска: корень в ячейке 1, дети узла k — в 2k и 2k+1
+ * (как в бинарной куче). Первые уровни дерева оказываются рядом в памяти и
+ * остаются в кэше, а спуск заменяется безветвлённым k = 2k + (data[k] < x).
+ *
+ * Потомки узла k через 4 уровня лежат подряд в ячейках [16k, 16k + 15] —
+ * это одна кэш-линия (16 * sizeof(int) = 64 байта), поэтому её можно
+ * запросить заранее (prefetch), пока идут сравнения на текущих уровнях.
+ *
+ * Сложности:
+ *   - построение: O(n), память: 2n int (элементы + исходные индексы)
+ *   - поиск: O(log n) без непредсказуемых ветвлений
+ */
+
+#include "eytzinger_search.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define EYTZINGER_ALIGN 64
+/* 16 int в кэш-линии — prefetch на 4 уровня вперёд */
+#define EYTZINGER_BLOCK 16
+
+#if defined(__GNUC__)
+#define EYTZINGER_PREFETCH(p) __builtin_prefetch(p)
+#define EYTZINGER_CTZ(x) ((unsigned)__builtin_ctz(x))
+#else
+#define EYTZINGER_PREFETCH(p) ((void)0)
+#define EYTZINGER_CTZ(x) eytzinger_ctz(x)
+
+/* Число младших нулевых битов; x != 0 */
+static unsigned eytzinger_ctz(unsigned x) {
+    unsigned c = 0;
+    while (!(x & 1u)) {
+        x >>= 1;
+        c++;
+    }
+    return c;
+}
+#endif
+
+static void *eytzinger_alloc(size_t bytes) {
+    /* aligned_alloc требует размер, кратный выравниванию */
+    bytes = (bytes + EYTZINGER_ALIGN - 1) / EYTZINGER_ALIGN * EYTZINGER_ALIGN;
+    return aligned_alloc(EYTZINGER_ALIGN, bytes);
+}
+
+/* Заполнение in-order обходом неявного дерева: i — следующий элемент arr */
+static int eytzinger_fill(const int arr[], eytzinger_t *e, int i, int k) {
+    if (k <= e->size) {
+        i = eytzinger_fill(arr, e, i, 2 * k);
+        e->data[k] = arr[i];
+        e->index[k] = i;
+        i++;
+        i = eytzinger_fill(arr, e, i, 2 * k + 1);
+    }
+    return i;
+}
+
+eytzinger_t *eytzinger_build(const int arr[], int size) {
+    if (size < 0) return NULL;
+    eytzinger_t *e = malloc(sizeof(eytzinger_t));
+    if (!e) return NULL;
+    e->size = size;
+    e->data = eytzinger_alloc(sizeof(int) * ((size_t)size + 1));
+    e->index = malloc(sizeof(int) * ((size_t)size + 1));
+    if (!e->data || !e->index) {
+        eytzinger_destroy(e);
+        return NULL;
+    }
+    e->data[0] = 0;
+    e->index[0] = size; /* k = 0 означает «все элементы меньше target» */
+    eytzinger_fill(arr, e, 0, 1);
+    return e;
+}
+
+void eytzinger_destroy(eytzinger_t *e) {
+    if (!e) return;
+    free(e->data);
+    free(e->index);
+    free(e);
+}
+
+/* Номер узла с первым элементом >= target или 0, если такого нет */
+static unsigned eytzinger_descend(const eytzinger_t *e, int target) {
+    const int *data = e->data;
+    unsigned n = (unsigned)e->size;
+    unsigned k = 1;
+    while (k <= n) {
+        EYTZINGER_PREFETCH(data + (size_t)k * EYTZINGER_BLOCK);
+        k = 2 * k + (data[k] < target);
+    }
+    /* Снимаем хвост из единиц (последние повороты вправо) и ещё один бит */
+    k >>= EYTZINGER_CTZ(~k);
+    k >>= 1;
+    return k;
+}
+
+// Индекс первого элемента >= target в исходном массиве (size, если такого нет)
+int eytzinger_lower_bound(const eytzinger_t *e, int target) {
+    return e->index[eytzinger_descend(e, target)];
+}
+
+// Индекс элемента, равного target, в исходном массиве или -1
+int eytzinger_search(const eytzinger_t *e, int target) {
+    unsigned k = eytzinger_descend(e, target);
+    if (k == 0 || e->data[k] != target) return -1;
+    return e->index[k];
+}
@@ -1,3 +1,9 @@
+#include "fast_pow.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
 double fast_pow(double x, int n) {
     double result = 1.0;
     long long power = n;
@@ -16,3 +22,61 @@ double fast_pow(double x, int n) {
     }
     return result;
 }
+
+/* Сколько пар обрабатывается одним блоком (4 double — регистр AVX2) */
+#define FAST_POW_LANES 4
+
+/*
+ * out[i] = fast_pow(x[i], n[i]) для массива пар.
+ * Тот же square-and-multiply, но по FAST_POW_LANES парам сразу: умножение
+ * result *= x выполняется во всех дорожках и применяется по маске младшего
+ * бита показателя, а цикл идёт до старшего бита наибольшего показателя в
+ * блоке. Последовательность умножений в каждой дорожке та же, что в
+ * fast_pow, поэтому результаты совпадают бит в бит.
+ */
+void fast_pow_batch(const double x[], const int n[], size_t count, double out[]) {
+    size_t i = 0;
+    for (; i + FAST_POW_LANES <= count; i += FAST_POW_LANES) {
+        double base[FAST_POW_LANES];
+        long long power[FAST_POW_LANES];
+        long long all = 0;
+        for (int l = 0; l < FAST_POW_LANES; l++) {
+            long long p = n[i + l];
+            base[l] = p < 0 ? 1.0 / x[i + l] : x[i + l];
+            power[l] = p < 0 ? -p : p;
+            all |= power[l];
+        }
+
+#if defined(__AVX2__)
+        __m256d vx = _mm256_loadu_pd(base);
+        __m256d vr = _mm256_set1_pd(1.0);
+        __m256i vp = _mm256_loadu_si256((const __m256i *)power);
+        const __m256i one = _mm256_set1_epi64x(1);
+        while (all > 0) {
+            // Маска дорожек с единичным младшим битом показателя
+            __m256i bit = _mm256_cmpeq_epi64(_mm256_and_si256(vp, one), one);
+            vr = _mm256_blendv_pd(vr, _mm256_mul_pd(vr, vx), _mm256_castsi256_pd(bit));
+            vx = _mm256_mul_pd(vx, vx);
+            vp = _mm256_srli_epi64(vp, 1);
+            all >>= 1;
+        }
+        _mm256_storeu_pd(out + i, vr);
+#else
+        double result[FAST_POW_LANES] = { 1.0, 1.0, 1.0, 1.0 };
+        while (all > 0) {
+            // Без ветвлений по дорожкам — цикл векторизуется компилятором
+            for (int l = 0; l < FAST_POW_LANES; l++) {
+                double m = result[l] * base[l];
+                result[l] = (power[l] & 1) ? m : result[l];
+                base[l] *= base[l];
+                power[l] >>= 1;
+            }
+            all >>= 1;
+        }
+        for (int l = 0; l < FAST_POW_LANES; l++) out[i + l] = result[l];
+#endif
+    }
+    for (; i < count; i++) {
+        out[i] = fast_pow(x[i], n[i]);
+    }
+}
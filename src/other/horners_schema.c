@@ -1,35 +1,307 @@
-int find_index(char symbol, char* alphabet) {
-    for (int i = 0; alphabet[i] != '\0'; i++) {
-        if (alphabet[i] == symbol) {
-            return i;
+#include "horners_schema.h"
+#include <limits.h>
+#include <string.h>
+
+/* Значение символа-цифры (0..35, регистр не важен) или 255 для остальных байтов */
+static const unsigned char digit_value[256] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+      0,   1,   2,   3,   4,   5,   6,   7,   8,   9, 255, 255, 255, 255, 255, 255,
+    255,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+     25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35, 255, 255, 255, 255, 255,
+    255,  10,  11,  12,  13,  14,  15,  16,  17,  18,  19,  20,  21,  22,  23,  24,
+     25,  26,  27,  28,  29,  30,  31,  32,  33,  34,  35, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+};
+
+#if defined(__GNUC__)
+/* *r = a * b + c; ненулевое значение — переполнение uint64_t */
+static inline int mul_add_overflow(uint64_t a, uint64_t b, uint64_t c, uint64_t *r) {
+    return __builtin_mul_overflow(a, b, r) || __builtin_add_overflow(*r, c, r);
+}
+
+/* Число младших нулевых битов; x != 0 */
+static inline unsigned ctz64(uint64_t x) {
+    return (unsigned)__builtin_ctzll(x);
+}
+
+/* Число старших нулевых битов; x != 0 */
+static inline unsigned clz64(uint64_t x) {
+    return (unsigned)__builtin_clzll(x);
+}
+
+#define DIGITS_INLINE static inline __attribute__((always_inline))
+#else
+static inline int mul_add_overflow(uint64_t a, uint64_t b, uint64_t c, uint64_t *r) {
+    if (b != 0 && a > UINT64_MAX / b) return 1;
+    a *= b;
+    if (a > UINT64_MAX - c) return 1;
+    *r = a + c;
+    return 0;
+}
+
+static inline unsigned ctz64(uint64_t x) {
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+}
+
+static inline unsigned clz64(uint64_t x) {
+    unsigned n = 0;
+    while (!(x >> 63)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+}
+
+#define DIGITS_INLINE static inline
+#endif
+
+#define ONES  0x0101010101010101ULL
+#define HIGHS 0x8080808080808080ULL
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define PARSE_SWAR 1
+#endif
+
+#if defined(PARSE_SWAR)
+/*
+ * Схема Горнера сразу для 8 цифр в одном uint64_t (SWAR): первая цифра — в
+ * младшем байте. Соседние байты сливаются в 16-битные пары d0 * b + d1,
+ * пары — в 32-битные четвёрки, четвёрки — в число до b^8 - 1.
+ */
+static inline uint64_t swar_combine8(uint64_t d, uint64_t base) {
+    d = (d & 0x00FF00FF00FF00FFULL) * base + ((d >> 8) & 0x00FF00FF00FF00FFULL);
+    d = (d & 0x0000FFFF0000FFFFULL) * (base * base) + ((d >> 16) & 0x0000FFFF0000FFFFULL);
+    return (d & 0xFFFFFFFFULL) * (base * base * base * base) + (d >> 32);
+}
+
+/* 8 символов -> вектор цифр; *bad != 0, если среди них не цифра основания base */
+static inline uint64_t swar_digits8(const char *s, unsigned base, uint64_t *bad) {
+    uint64_t chunk;
+    memcpy(&chunk, s, 8);
+    if (base <= 10) {
+        // Без таблицы: байт — цифра, если '0' <= c < '0' + base
+        uint64_t d = chunk - 0x30 * ONES;
+        *bad = (chunk | d | (chunk + (0x80 - 0x30 - base) * ONES)) & HIGHS;
+        return d;
+    }
+    const unsigned char *u = (const unsigned char *)s;
+    uint64_t d = (uint64_t)digit_value[u[0]]
+               | (uint64_t)digit_value[u[1]] << 8
+               | (uint64_t)digit_value[u[2]] << 16
+               | (uint64_t)digit_value[u[3]] << 24
+               | (uint64_t)digit_value[u[4]] << 32
+               | (uint64_t)digit_value[u[5]] << 40
+               | (uint64_t)digit_value[u[6]] << 48
+               | (uint64_t)digit_value[u[7]] << 56;
+    // Неверные байты (255) уже с установленным старшим битом; цифры >= base его получают
+    *bad = (d | (d + (0x80 - base) * ONES)) & HIGHS;
+    return d;
+}
+#endif
+
+/* Остаток строки после переполнения: неверная цифра важнее переполнения */
+static int check_digits(const char *str, size_t len, unsigned base) {
+    for (size_t i = 0; i < len; i++) {
+        if (digit_value[(unsigned char)str[i]] >= base) return BASE_BAD_DIGIT;
+    }
+    return BASE_OVERFLOW;
+}
+
+/*
+ * Разбор len символов str как числа в системе base (2..36) в *value.
+ * Точное 64-битное накопление с проверкой переполнения (BASE_BAD_DIGIT имеет приоритет
+ * над BASE_OVERFLOW), цифры — по таблице,
+ * по 8 цифр за шаг (SWAR) на little-endian.
+ */
+int parse_base(const char *str, size_t len, int base, uint64_t *value) {
+    if (base < 2 || base > 36) return BASE_BAD_BASE;
+    if (len == 0) return BASE_BAD_DIGIT;
+
+    uint64_t b = (uint64_t)base;
+    uint64_t result = 0;
+    size_t i = 0;
+
+#if defined(PARSE_SWAR)
+    uint64_t b8 = b * b * b * b * b * b * b * b;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t bad;
+        uint64_t d = swar_digits8(str + i, (unsigned)base, &bad);
+        if (bad) return BASE_BAD_DIGIT;
+        uint64_t chunk = swar_combine8(d, b);
+        if (mul_add_overflow(result, b8, chunk, &result)) {
+            return check_digits(str + i + 8, len - i - 8, (unsigned)base);
+        }
+    }
+#endif
+
+    for (; i < len; i++) {
+        unsigned d = digit_value[(unsigned char)str[i]];
+        if (d >= (unsigned)base) return BASE_BAD_DIGIT;
+        if (mul_add_overflow(result, b, d, &result)) {
+            return check_digits(str + i + 1, len - i - 1, (unsigned)base);
         }
     }
+    *value = result;
+    return BASE_OK;
+}
+
+/* Длина начального отрезка str из цифр системы base (до первой нецифры) */
+size_t base_span(const char *str, size_t len, int base) {
+    if (base < 2 || base > 36) return 0;
+    size_t i = 0;
+#if defined(PARSE_SWAR)
+    for (; i + 8 <= len; i += 8) {
+        uint64_t bad;
+        swar_digits8(str + i, (unsigned)base, &bad);
+        // Перенос между байтами возможен только от неверного байта, поэтому
+        // младший отмеченный байт — действительно первая нецифра
+        if (bad) return i + (size_t)(ctz64(bad) >> 3);
+    }
+#endif
+    while (i < len && digit_value[(unsigned char)str[i]] < (unsigned)base) i++;
+    return i;
 }
 
 int to_dec(char* str, int size, int base, long int * dec) {
-    char* alphabet = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-    double answer = 0.0;
-    int k = size-1;
-    for (int i = 0; str[i] != '\0'; i++, k--) {
-        int index = find_index(str[i], alphabet);
-        if (index >= base){
-            return -1;
-        }
-        answer *= base;
-        answer += index;
+    uint64_t value;
+    if (size < 0 || parse_base(str, (size_t)size, base, &value) != BASE_OK || value > LONG_MAX) {
+        return -1;
     }
-    *dec = (long int) answer;
+    *dec = (long int) value;
     return 0;
 }
 
+static const char digit_chars[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+
+/* Пары десятичных цифр "00".."99": одно деление на 100 даёт сразу две цифры */
+static const char dec_pairs[200] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const uint64_t pow10_table[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL,
+    100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL,
+    1000000000000000000ULL, 10000000000000000000ULL,
+};
+
+/* Количество цифр value в системе base (2..36); для нуля — одна цифра */
+size_t base_length(uint64_t value, int base) {
+    if (base < 2 || base > 36) return 0;
+    if (base == 10) {
+        // Оценка через число бит (log10(2) ~ 1233 / 4096) и одна поправка по таблице;
+        // младший бит не влияет на число цифр, а ноль превращается в единицу
+        uint64_t v = value | 1;
+        unsigned bits = 64 - clz64(v);
+        size_t n = (bits * 1233) >> 12;
+        return n + (v >= pow10_table[n]);
+    }
+    if ((base & (base - 1)) == 0) {
+        unsigned shift = ctz64((uint64_t)base);
+        unsigned bits = 64 - clz64(value | 1);
+        return (bits + shift - 1) / shift;
+    }
+    uint64_t b = (uint64_t)base;
+    size_t n = 1;
+    for (uint64_t p = b; p <= value; p *= b) {
+        n++;
+        if (p > UINT64_MAX / b) break;
+    }
+    return n;
+}
+
 /*
-int number = 100;
-int i = 0;
-char answer[BUFSIZ];
-char* alphabet = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ";
-while (number > 0){
-    char current = alphabet[(number % base)];
-    number /= base;
-    answer[i++] = current
-}
-*/
+ * Запись value справа налево, заканчивая перед end. При константном base
+ * (после встраивания) деления на base и base^2 компилятор заменяет
+ * умножением; за одно 64-битное деление получаются две цифры.
+ */
+DIGITS_INLINE void write_digits(uint64_t value, unsigned base, char *end) {
+    if (base == 10) {
+        while (value >= 100) {
+            unsigned r = (unsigned)(value % 100);
+            value /= 100;
+            end -= 2;
+            memcpy(end, dec_pairs + 2 * r, 2);
+        }
+        if (value >= 10) {
+            end -= 2;
+            memcpy(end, dec_pairs + 2 * value, 2);
+        } else {
+            *--end = (char)('0' + value);
+        }
+        return;
+    }
+    if ((base & (base - 1)) == 0) {
+        unsigned shift = ctz64(base);
+        do {
+            *--end = digit_chars[value & (base - 1)];
+            value >>= shift;
+        } while (value);
+        return;
+    }
+    uint64_t b2 = (uint64_t)base * base;
+    while (value >= b2) {
+        unsigned r = (unsigned)(value % b2);
+        value /= b2;
+        *--end = digit_chars[r % base];
+        *--end = digit_chars[r / base];
+    }
+    unsigned r = (unsigned)value;
+    *--end = digit_chars[r % base];
+    if (r >= base) *--end = digit_chars[r / base];
+}
+
+/*
+ * Запись value в системе base (2..36) в buf ёмкостью size с завершающим нулём.
+ * Длина вычисляется заранее, цифры пишутся сразу на свои места, без разворота.
+ */
+int format_base(uint64_t value, int base, char *buf, size_t size, size_t *len) {
+    if (base < 2 || base > 36) return BASE_BAD_BASE;
+    size_t n = base_length(value, base);
+    if (n >= size) return BASE_NO_SPACE;
+
+    char *end = buf + n;
+    *end = '\0';
+    switch (base) {
+        case 2:  write_digits(value, 2, end);  break;
+        case 8:  write_digits(value, 8, end);  break;
+        case 10: write_digits(value, 10, end); break;
+        case 16: write_digits(value, 16, end); break;
+        case 32: write_digits(value, 32, end); break;
+        case 36: write_digits(value, 36, end); break;
+        default: write_digits(value, (unsigned)base, end); break;
+    }
+    if (len) *len = n;
+    return BASE_OK;
+}
+
+int from_dec(long int dec, int base, char* str, int size) {
+    if (size <= 0 || base < 2 || base > 36) return -1;
+    size_t cap = (size_t)size;
+    uint64_t magnitude = dec < 0 ? 0 - (uint64_t)dec : (uint64_t)dec;
+    // Место проверяем до записи знака, чтобы при ошибке str остался нетронутым
+    if (base_length(magnitude, base) + (dec < 0) >= cap) return -1;
+    if (dec < 0) {
+        *str++ = '-';
+        cap--;
+    }
+    return format_base(magnitude, base, str, cap, NULL) == BASE_OK ? 0 : -1;
+}
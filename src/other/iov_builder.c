@@ -0,0 +1,96 @@
+/**
+ * iov_builder.c
+ *
+ * Сборка вывода из кусков с отправкой через writev
+ *
+ * Вместо concat + write + free: длинные куски не копируются вовсе, в
+ * iovec попадают их адреса, а мелкие (разделители, числа) дописываются во
+ * встроенный буфер — иначе на каждый байт-разделитель тратилась бы целая
+ * запись iovec. Подряд идущие мелкие куски склеиваются в одну запись.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "iov_builder.h"
+#include "string_concatinate.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+void iov_builder_init(iov_builder_t *b, int fd) {
+    b->fd = fd;
+    b->status = CONCAT_OK;
+    b->count = 0;
+    b->inline_used = 0;
+}
+
+/* Запись всех кусков; частичную запись writev досылаем с места остановки */
+int iov_builder_flush(iov_builder_t *b) {
+    struct iovec *iov = b->iov;
+    int count = b->count;
+    while (b->status == CONCAT_OK && count > 0) {
+        ssize_t n = writev(b->fd, iov, count);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            b->status = CONCAT_IO_ERR;
+            break;
+        }
+        size_t done = (size_t)n;
+        while (count > 0 && done >= iov->iov_len) {
+            done -= iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + done;
+            iov->iov_len -= done;
+        }
+    }
+    b->count = 0;
+    b->inline_used = 0;
+    return b->status;
+}
+
+static inline void push_piece(iov_builder_t *b, const char *ptr, size_t len) {
+    if (b->count == IOV_BUILDER_PIECES) iov_builder_flush(b);
+    b->iov[b->count].iov_base = (void *)ptr;
+    b->iov[b->count].iov_len = len;
+    b->count++;
+}
+
+/* Копия во встроенный буфер; продолжение предыдущей копии — та же запись iovec */
+static void push_inline(iov_builder_t *b, const char *ptr, size_t len) {
+    // Сброс до копирования: после него буфер переиспользуется с начала
+    if (IOV_BUILDER_INLINE - b->inline_used < len || b->count == IOV_BUILDER_PIECES) {
+        iov_builder_flush(b);
+    }
+    char *dst = b->inline_buf + b->inline_used;
+    memcpy(dst, ptr, len);
+    b->inline_used += len;
+
+    struct iovec *last = b->count > 0 ? &b->iov[b->count - 1] : NULL;
+    if (last && (char *)last->iov_base + last->iov_len == dst) {
+        last->iov_len += len;
+    } else {
+        push_piece(b, dst, len);
+    }
+}
+
+void iov_builder_add(iov_builder_t *b, const char *ptr, size_t len) {
+    if (b->status != CONCAT_OK || len == 0) return;
+    if (len < IOV_BUILDER_SMALL) {
+        push_inline(b, ptr, len);
+    } else {
+        push_piece(b, ptr, len);
+    }
+}
+
+/* Для временных данных: копируется всегда, длинные — частями по размеру буфера */
+void iov_builder_add_copy(iov_builder_t *b, const char *ptr, size_t len) {
+    while (b->status == CONCAT_OK && len > 0) {
+        size_t n = len < IOV_BUILDER_INLINE ? len : IOV_BUILDER_INLINE;
+        push_inline(b, ptr, n);
+        ptr += n;
+        len -= n;
+    }
+}
@@ -0,0 +1,198 @@
+/**
+ * ksection_search.c
+ *
+ * Параллельный k-секционный поиск по монотонному предикату
+ *
+ * Бинарный поиск вычисляет предикат в одной точке за раунд и сужает
+ * интервал вдвое. Если предикат дорогой (миллисекунды) и есть k ядер,
+ * выгоднее за раунд вычислить его в k равноотстоящих точках параллельно:
+ * интервал сужается в k + 1 раз, и раундов нужно log_{k+1}(n) вместо
+ * log2(n) — при k = 15 вчетверо меньше.
+ *
+ * Потоки создаются один раз на весь поиск и ждут начала раунда на условной
+ * переменной: создание потока на каждую точку стоило бы больше, чем
+ * экономия на коротких раундах.
+ *
+ * Тестовый main — под макросом KSECTION_SEARCH_TEST.
+ */
+
+#include "ksection_search.h"
+#include <pthread.h>
+#include <stdlib.h>
+
+typedef struct ksection_shared_ ksection_shared_t;
+
+typedef struct {
+    ksection_shared_t *shared;
+    int id;
+} ksection_worker_t;
+
+struct ksection_shared_ {
+    pthread_mutex_t lock;
+    pthread_cond_t start;   /* начался новый раунд или пора завершаться */
+    pthread_cond_t done;    /* все рабочие потоки закончили раунд */
+    unsigned round;
+    int pending;            /* рабочих потоков, ещё не закончивших раунд */
+    bool stop;
+    monotone_pred_t pred;
+    void *ctx;
+    long *points;           /* точки текущего раунда */
+    bool *results;
+    int count;              /* точек в текущем раунде */
+};
+
+static void *ksection_worker(void *arg) {
+    ksection_worker_t *w = arg;
+    ksection_shared_t *s = w->shared;
+    unsigned seen = 0;
+
+    pthread_mutex_lock(&s->lock);
+    for (;;) {
+        while (s->round == seen && !s->stop) pthread_cond_wait(&s->start, &s->lock);
+        if (s->stop) break;
+        seen = s->round;
+        int count = s->count;
+        pthread_mutex_unlock(&s->lock);
+
+        if (w->id < count) {
+            s->results[w->id] = s->pred(s->points[w->id], s->ctx);
+        }
+
+        pthread_mutex_lock(&s->lock);
+        if (--s->pending == 0) pthread_cond_signal(&s->done);
+    }
+    pthread_mutex_unlock(&s->lock);
+    return NULL;
+}
+
+/* Сужает [*lo, *hi) по результатам в возрастающих точках points[0..count) */
+static void ksection_narrow(long *lo, long *hi, const long *points, const bool *results, int count) {
+    for (int i = 0; i < count; i++) {
+        if (results[i]) {
+            *hi = points[i];
+            return;
+        }
+        *lo = points[i] + 1;
+    }
+}
+
+/*
+ * Первое x из [lo, hi), для которого pred(x) истинен, или hi, если таких нет.
+ * Предикат вызывается одновременно из threads потоков и должен быть потокобезопасным.
+ */
+long ksection_search(long lo, long hi, monotone_pred_t pred, void *ctx, int threads) {
+    if (threads < 1) threads = 1;
+
+    ksection_shared_t s;
+    s.points = malloc(sizeof(long) * (size_t)threads);
+    s.results = malloc(sizeof(bool) * (size_t)threads);
+    ksection_worker_t *workers = malloc(sizeof(ksection_worker_t) * (size_t)threads);
+    pthread_t *tids = malloc(sizeof(pthread_t) * (size_t)threads);
+    if (!s.points || !s.results || !workers || !tids) {
+        free(s.points);
+        free(s.results);
+        free(workers);
+        free(tids);
+        // Без памяти под раунд — обычная бисекция в текущем потоке
+        while (lo < hi) {
+            long mid = lo + (long)(((unsigned long)hi - (unsigned long)lo) / 2);
+            if (pred(mid, ctx)) {
+                hi = mid;
+            } else {
+                lo = mid + 1;
+            }
+        }
+        return lo;
+    }
+
+    pthread_mutex_init(&s.lock, NULL);
+    pthread_cond_init(&s.start, NULL);
+    pthread_cond_init(&s.done, NULL);
+    s.round = 0;
+    s.pending = 0;
+    s.stop = false;
+    s.pred = pred;
+    s.ctx = ctx;
+    s.count = 0;
+
+    // Вызывающий поток считает точку 0; если часть потоков не создалась, работаем с остальными
+    int participants = 1;
+    for (int i = 1; i < threads; i++) {
+        workers[i].shared = &s;
+        workers[i].id = i;
+        if (pthread_create(&tids[i], NULL, ksection_worker, &workers[i]) != 0) break;
+        participants++;
+    }
+
+    while (lo < hi) {
+        // k точек внутри [lo, hi) делят интервал на k + 1 частей.
+        // Длина — unsigned long: hi - lo переполняет long на [LONG_MIN, LONG_MAX)
+        unsigned long len = (unsigned long)hi - (unsigned long)lo;
+        int k = len < (unsigned long)participants ? (int)len : participants;
+        unsigned long step = len / (unsigned long)(k + 1);
+        unsigned long rem = len % (unsigned long)(k + 1);
+        for (int i = 0; i < k; i++) {
+            // floor(len * (i + 1) / (k + 1)) без переполнения; точки строго возрастают
+            unsigned long off = step * (unsigned long)(i + 1) + rem * (unsigned long)(i + 1) / (unsigned long)(k + 1);
+            s.points[i] = (long)((unsigned long)lo + off);
+        }
+
+        pthread_mutex_lock(&s.lock);
+        s.count = k;
+        s.pending = participants - 1;
+        s.round++;
+        pthread_cond_broadcast(&s.start);
+        pthread_mutex_unlock(&s.lock);
+
+        s.results[0] = pred(s.points[0], ctx);
+
+        pthread_mutex_lock(&s.lock);
+        while (s.pending > 0) pthread_cond_wait(&s.done, &s.lock);
+        pthread_mutex_unlock(&s.lock);
+
+        ksection_narrow(&lo, &hi, s.points, s.results, k);
+    }
+
+    pthread_mutex_lock(&s.lock);
+    s.stop = true;
+    pthread_cond_broadcast(&s.start);
+    pthread_mutex_unlock(&s.lock);
+    for (int i = 1; i < participants; i++) pthread_join(tids[i], NULL);
+
+    pthread_cond_destroy(&s.start);
+    pthread_cond_destroy(&s.done);
+    pthread_mutex_destroy(&s.lock);
+    free(s.points);
+    free(s.results);
+    free(workers);
+    free(tids);
+    return lo;
+}
+
+#ifdef KSECTION_SEARCH_TEST
+#include <limits.h>
+#include <stdio.h>
+
+static bool at_least(long x, void *ctx) {
+    return x >= *(const long *)ctx;
+}
+
+int main(void) {
+    // Весь диапазон long: hi - lo не помещается в long
+    static const long targets[] = { LONG_MIN, LONG_MIN + 1, -1, 0, 1, 123456789012345L, LONG_MAX - 1, LONG_MAX };
+    int failed = 0;
+    for (int threads = 1; threads <= 16; threads *= 2) {
+        for (size_t i = 0; i < sizeof(targets) / sizeof(targets[0]); i++) {
+            long found = ksection_search(LONG_MIN, LONG_MAX, at_least, (void *)&targets[i], threads);
+            if (found != targets[i]) {
+                printf("threads = %d: expected %ld, got %ld\n", threads, targets[i], found);
+                failed = 1;
+            }
+        }
+    }
+    long target = 1000;
+    printf("first x >= 1000 in [0, 100): %ld\n", ksection_search(0, 100, at_least, &target, 4));
+    printf("full-range search: %s\n", failed ? "FAIL" : "ok");
+    return failed;
+}
+#endif /* KSECTION_SEARCH_TEST */
@@ -0,0 +1,165 @@
+/**
+ * learned_index.c
+ *
+ * Обученный индекс (learned index) над отсортированным массивом int
+ *
+ * Позиция ключа в отсортированном массиве — монотонная функция ключа. Для
+ * гладких распределений (метки времени, последовательные id) её хорошо
+ * приближает кусочно-линейная модель. Отрезки строятся жадно методом
+ * «сужающегося конуса»: от первой точки отрезка поддерживается интервал
+ * допустимых наклонов, при которых все точки отрезка предсказываются с
+ * ошибкой не больше eps; как только интервал становится пустым, начинается
+ * новый отрезок.
+ *
+ * Модель обучается на точках (ключ, позиция первого вхождения), а также
+ * (ключ + 1, позиция следующего ключа) для пропусков между ключами, поэтому
+ * ошибка eps гарантирована для любого искомого int, а не только для
+ * присутствующих в массиве.
+ *
+ * Поиск: отрезок ищется по массиву первых ключей (их мало, он в кэше),
+ * затем предсказанная позиция уточняется поиском в окне из 2 * eps + 3
+ * элементов — для eps = 8 это одна-две кэш-линии.
+ */
+
+#include "learned_index.h"
+#include "binary_search.h"
+#include "search_types.h"
+#include <math.h>
+#include <stdlib.h>
+
+typedef struct {
+    int64_t x0;
+    int y0;
+    int64_t last_x;
+    double lo, hi;     /* интервал допустимых наклонов */
+    int open;
+} learned_cone_t;
+
+static int learned_push_segment(learned_index_t *li, const learned_cone_t *c, int *capacity) {
+    if (li->seg_count == *capacity) {
+        int new_capacity = *capacity ? *capacity * 2 : 16;
+        int64_t *keys = realloc(li->seg_keys, sizeof(int64_t) * new_capacity);
+        if (!keys) return -1;
+        li->seg_keys = keys;
+        learned_segment_t *segs = realloc(li->segs, sizeof(learned_segment_t) * new_capacity);
+        if (!segs) return -1;
+        li->segs = segs;
+        *capacity = new_capacity;
+    }
+    learned_segment_t *s = &li->segs[li->seg_count];
+    /* Отрезок из одной точки: наклон не ограничен, берём 0 */
+    s->slope = isinf(c->lo) ? 0.0 : (c->lo + c->hi) / 2;
+    s->first_pos = c->y0;
+    s->last_key = c->last_x;
+    li->seg_keys[li->seg_count] = c->x0;
+    li->seg_count++;
+    return 0;
+}
+
+static int learned_add_point(learned_index_t *li, learned_cone_t *c, int64_t x, int y, int *capacity) {
+    if (c->open) {
+        double dx = (double)(x - c->x0);
+        double plo = ((double)y - li->eps - c->y0) / dx;
+        double phi = ((double)y + li->eps - c->y0) / dx;
+        if (plo <= c->hi && phi >= c->lo) {
+            if (plo > c->lo) c->lo = plo;
+            if (phi < c->hi) c->hi = phi;
+            c->last_x = x;
+            return 0;
+        }
+        // Точка не помещается в конус — закрываем отрезок
+        if (learned_push_segment(li, c, capacity) != 0) return -1;
+    }
+    c->open = 1;
+    c->x0 = x;
+    c->y0 = y;
+    c->last_x = x;
+    c->lo = -INFINITY;
+    c->hi = INFINITY;
+    return 0;
+}
+
+learned_index_t *learned_index_build(const int arr[], int size, int eps) {
+    if (size < 0 || eps < 0) return NULL;
+    learned_index_t *li = malloc(sizeof(learned_index_t));
+    if (!li) return NULL;
+    li->arr = arr;
+    li->size = size;
+    li->eps = eps;
+    li->seg_keys = NULL;
+    li->segs = NULL;
+    li->seg_count = 0;
+
+    int capacity = 0;
+    learned_cone_t cone = { 0 };
+    int i = 0;
+    while (i < size) {
+        int key = arr[i];
+        int j = i + 1;
+        while (j < size && arr[j] == key) j++; // пропускаем дубликаты
+
+        int fail = learned_add_point(li, &cone, key, i, &capacity);
+        // Все int из (key, arr[j]) имеют lower bound j
+        if (!fail && key != INT32_MAX && (j == size || (int64_t)key + 1 < arr[j]))
+            fail = learned_add_point(li, &cone, (int64_t)key + 1, j, &capacity);
+        if (fail) {
+            learned_index_destroy(li);
+            return NULL;
+        }
+        i = j;
+    }
+    if (cone.open && learned_push_segment(li, &cone, &capacity) != 0) {
+        learned_index_destroy(li);
+        return NULL;
+    }
+    return li;
+}
+
+void learned_index_destroy(learned_index_t *li) {
+    if (!li) return;
+    free(li->seg_keys);
+    free(li->segs);
+    free(li);
+}
+
+/*
+ * Окно [*lo, *hi), в котором лежит lower bound для target (возможно, *hi).
+ * Если ответ известен без поиска, *lo == *hi == ответ.
+ */
+static void learned_window(const learned_index_t *li, int target, int *lo, int *hi) {
+    if (li->seg_count == 0 || target < li->seg_keys[0]) {
+        *lo = *hi = 0;
+        return;
+    }
+    int s = (int)i64search_upper_bound(li->seg_keys, (size_t)li->seg_count, target) - 1;
+    const learned_segment_t *seg = &li->segs[s];
+    int seg_end = s + 1 < li->seg_count ? li->segs[s + 1].first_pos : li->size;
+
+    // Между последней точкой отрезка и началом следующего ответ один и тот же
+    if (target > seg->last_key) {
+        *lo = *hi = seg_end;
+        return;
+    }
+
+    double pred = seg->first_pos + seg->slope * (double)((int64_t)target - li->seg_keys[s]);
+    int64_t p = (int64_t)floor(pred);
+    int64_t l = p - li->eps - 1; // +1 — запас на округление
+    int64_t h = p + li->eps + 2;
+    *lo = l < seg->first_pos ? seg->first_pos : (int)l;
+    *hi = h > seg_end ? seg_end : (int)h;
+}
+
+// Индекс первого элемента >= target (size, если такого нет)
+int learned_index_lower_bound(const learned_index_t *li, int target) {
+    int lo, hi;
+    learned_window(li, target, &lo, &hi);
+    return lo + (int)isearch_lower_bound(li->arr + lo, (size_t)(hi - lo), target);
+}
+
+// Индекс элемента, равного target, или -1
+int learned_index_search(const learned_index_t *li, int target) {
+    int lo, hi;
+    learned_window(li, target, &lo, &hi);
+    int found = binary_search(li->arr + lo, hi - lo, target);
+    return found < 0 ? -1 : lo + found;
+}
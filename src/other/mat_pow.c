@@ -0,0 +1,179 @@
+/**
+ * mat_pow.c
+ *
+ * Возведение матрицы в степень для линейных рекуррент
+ *
+ * Рекуррента порядка k (например, Фибоначчи: F(n+1) = F(n) + F(n-1))
+ * записывается как v(n+1) = M * v(n) с матрицей k x k, и n-й член —
+ * это M^n * v(0). Square-and-multiply из fast_pow работает и для матриц:
+ * 10^12-й член — около 80 умножений вместо 10^12 шагов.
+ *
+ * Умножение:
+ *   - n = 2, 3, 4 — ядро с константным n: компилятор полностью разворачивает
+ *     циклы;
+ *   - до MAT_BLOCK — порядок i-k-j: внутренний цикл идёт по строкам b и c
+ *     подряд и векторизуется;
+ *   - больше — тот же порядок поблочно (MAT_BLOCK x MAT_BLOCK), чтобы
+ *     блоки a, b и c одновременно помещались в L1/L2.
+ *
+ * Семейства для double, целых mod 2^64 и по модулю генерируются макросом
+ * MAT_DEF; для модуля элементы переводятся в рабочую форму mod_pow.h
+ * (Монтгомери) один раз на всё возведение.
+ */
+
+#include "mat_pow.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define MAT_BLOCK 64
+
+/* Операции поэлементной арифметики для каждого семейства */
+#define F64_MADD(acc, x, y, ctx) ((void)(ctx), (acc) + (x) * (y))
+#define U64_MADD(acc, x, y, ctx) ((void)(ctx), (acc) + (x) * (y))
+#define MOD_MADD(acc, x, y, ctx) mod_form_add((ctx), (acc), mod_form_mul((ctx), (x), (y)))
+
+#define MAT_DEF(dtype, dname, ctx_t, madd)                                                   \
+                                                                                             \
+static inline void dname##_mul_fixed(const dtype *restrict a, const dtype *restrict b,       \
+                                     dtype *restrict c, size_t n, ctx_t ctx) {               \
+    memset(c, 0, sizeof(dtype) * n * n);                                                     \
+    for (size_t i = 0; i < n; i++) {                                                         \
+        for (size_t k = 0; k < n; k++) {                                                     \
+            dtype aik = a[i * n + k];                                                        \
+            for (size_t j = 0; j < n; j++) {                                                 \
+                c[i * n + j] = madd(c[i * n + j], aik, b[k * n + j], ctx);                   \
+            }                                                                                \
+        }                                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+static void dname##_mul_blocked(const dtype *restrict a, const dtype *restrict b,            \
+                                dtype *restrict c, size_t n, ctx_t ctx) {                    \
+    memset(c, 0, sizeof(dtype) * n * n);                                                     \
+    for (size_t ii = 0; ii < n; ii += MAT_BLOCK) {                                           \
+        size_t i_end = ii + MAT_BLOCK < n ? ii + MAT_BLOCK : n;                              \
+        for (size_t kk = 0; kk < n; kk += MAT_BLOCK) {                                       \
+            size_t k_end = kk + MAT_BLOCK < n ? kk + MAT_BLOCK : n;                          \
+            for (size_t jj = 0; jj < n; jj += MAT_BLOCK) {                                   \
+                size_t j_end = jj + MAT_BLOCK < n ? jj + MAT_BLOCK : n;                      \
+                for (size_t i = ii; i < i_end; i++) {                                        \
+                    dtype *restrict ci = c + i * n;                                          \
+                    for (size_t k = kk; k < k_end; k++) {                                    \
+                        dtype aik = a[i * n + k];                                            \
+                        const dtype *restrict bk = b + k * n;                                \
+                        for (size_t j = jj; j < j_end; j++) {                                \
+                            ci[j] = madd(ci[j], aik, bk[j], ctx);                            \
+                        }                                                                    \
+                    }                                                                        \
+                }                                                                            \
+            }                                                                                \
+        }                                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+static void dname##_mul(const dtype *a, const dtype *b, dtype *c, size_t n, ctx_t ctx) {     \
+    switch (n) {                                                                             \
+    case 2: dname##_mul_fixed(a, b, c, 2, ctx); break;                                       \
+    case 3: dname##_mul_fixed(a, b, c, 3, ctx); break;                                       \
+    case 4: dname##_mul_fixed(a, b, c, 4, ctx); break;                                       \
+    default:                                                                                 \
+        if (n <= MAT_BLOCK) {                                                                \
+            dname##_mul_fixed(a, b, c, n, ctx);                                              \
+        } else {                                                                             \
+            dname##_mul_blocked(a, b, c, n, ctx);                                            \
+        }                                                                                    \
+    }                                                                                        \
+}                                                                                            \
+                                                                                             \
+/* out = a^e; one — единица в используемой форме */                                          \
+static int dname##_pow(const dtype *a, uint64_t e, dtype *out, size_t n, dtype one,          \
+                       ctx_t ctx) {                                                          \
+    size_t bytes = sizeof(dtype) * n * n;                                                    \
+    dtype *x = malloc(bytes ? bytes : 1);                                                    \
+    dtype *tmp = malloc(bytes ? bytes : 1);                                                  \
+    if (!x || !tmp) {                                                                        \
+        free(x);                                                                             \
+        free(tmp);                                                                           \
+        return -1;                                                                           \
+    }                                                                                        \
+    memcpy(x, a, bytes);                                                                     \
+    memset(out, 0, bytes);                                                                   \
+    for (size_t i = 0; i < n; i++) out[i * n + i] = one;                                     \
+                                                                                             \
+    while (e > 0) {                                                                          \
+        if (e & 1) {                                                                         \
+            dname##_mul(out, x, tmp, n, ctx);                                                \
+            memcpy(out, tmp, bytes);                                                         \
+        }                                                                                    \
+        e >>= 1;                                                                             \
+        if (e > 0) {                                                                         \
+            dname##_mul(x, x, tmp, n, ctx);                                                  \
+            memcpy(x, tmp, bytes);                                                           \
+        }                                                                                    \
+    }                                                                                        \
+    free(x);                                                                                 \
+    free(tmp);                                                                               \
+    return 0;                                                                                \
+}                                                                                            \
+
+MAT_DEF(double, f64, const void *, F64_MADD)
+MAT_DEF(uint64_t, u64, const void *, U64_MADD)
+MAT_DEF(uint64_t, modm, const mod_ctx_t *, MOD_MADD)
+
+void mat_mul_f64(size_t n, const double *a, const double *b, double *c) {
+    f64_mul(a, b, c, n, NULL);
+}
+
+int mat_pow_f64(size_t n, const double *a, uint64_t e, double *out) {
+    return f64_pow(a, e, out, n, 1.0, NULL);
+}
+
+void mat_mul_u64(size_t n, const uint64_t *a, const uint64_t *b, uint64_t *c) {
+    u64_mul(a, b, c, n, NULL);
+}
+
+int mat_pow_u64(size_t n, const uint64_t *a, uint64_t e, uint64_t *out) {
+    return u64_pow(a, e, out, n, 1, NULL);
+}
+
+/* Копии операндов в рабочей форме модуля */
+static uint64_t *mat_form_in(const mod_ctx_t *ctx, size_t n, const uint64_t *a) {
+    size_t count = n * n;
+    uint64_t *f = malloc(sizeof(uint64_t) * (count ? count : 1));
+    if (!f) return NULL;
+    for (size_t i = 0; i < count; i++) f[i] = mod_form_in(ctx, a[i]);
+    return f;
+}
+
+void mat_mul_mod(const mod_ctx_t *ctx, size_t n, const uint64_t *a, const uint64_t *b, uint64_t *c) {
+    uint64_t *fa = mat_form_in(ctx, n, a);
+    uint64_t *fb = mat_form_in(ctx, n, b);
+    if (fa && fb) {
+        modm_mul(fa, fb, c, n, ctx);
+        for (size_t i = 0; i < n * n; i++) c[i] = mod_form_out(ctx, c[i]);
+    } else {
+        // Без памяти под копии — поэлементно через mod_mul
+        for (size_t i = 0; i < n; i++) {
+            for (size_t j = 0; j < n; j++) {
+                uint64_t acc = 0;
+                for (size_t k = 0; k < n; k++) {
+                    acc = mod_form_add(ctx, acc, mod_mul(ctx, a[i * n + k], b[k * n + j]));
+                }
+                c[i * n + j] = acc;
+            }
+        }
+    }
+    free(fa);
+    free(fb);
+}
+
+int mat_pow_mod(const mod_ctx_t *ctx, size_t n, const uint64_t *a, uint64_t e, uint64_t *out) {
+    uint64_t *fa = mat_form_in(ctx, n, a);
+    if (!fa) return -1;
+    int rc = modm_pow(fa, e, out, n, mod_form_in(ctx, 1), ctx);
+    if (rc == 0) {
+        for (size_t i = 0; i < n * n; i++) out[i] = mod_form_out(ctx, out[i]);
+    }
+    free(fa);
+    return rc;
+}
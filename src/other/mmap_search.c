@@ -0,0 +1,125 @@
+/**
+ * mmap_search.c
+ *
+ * Бинарный поиск по отсортированному файлу, отображённому в память
+ *
+ * Обычный бинарный поиск по файлу больше ОЗУ делает ~log2(n) обращений к
+ * случайным страницам, и почти каждое — page fault с чтением с диска.
+ * Здесь записи делятся на «страницы» по per_page = page_size / record_size
+ * записей (запись длиннее страницы — одна запись на «страницу»), и первый
+ * ключ каждой страницы хранится в обычном массиве в памяти. Поиск по этому
+ * массиву не трогает файл, после чего остаётся бинарный поиск внутри одной
+ * страницы — не больше одного page fault на запрос (двух, если размер
+ * записи не делит размер страницы и запись пересекает границу).
+ *
+ * Построение индекса читает по одному ключу с каждой страницы файла.
+ */
+
+#define _DEFAULT_SOURCE
+
+#include "mmap_search.h"
+#include "search_types.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Ключ записи; memcpy — запись может быть не выровнена под int */
+static inline int mmap_key(const mmap_search_t *ms, size_t i) {
+    int key;
+    memcpy(&key, ms->base + i * ms->record_size + ms->key_offset, sizeof(int));
+    return key;
+}
+
+mmap_search_t *mmap_search_open(const char *path, size_t record_size, size_t key_offset) {
+    if (!path || record_size == 0 || key_offset + sizeof(int) > record_size) return NULL;
+
+    mmap_search_t *ms = malloc(sizeof(mmap_search_t));
+    if (!ms) return NULL;
+    ms->base = NULL;
+    ms->page_keys = NULL;
+    ms->record_size = record_size;
+    ms->key_offset = key_offset;
+
+    ms->fd = open(path, O_RDONLY);
+    if (ms->fd < 0) {
+        free(ms);
+        return NULL;
+    }
+
+    struct stat st;
+    if (fstat(ms->fd, &st) != 0) {
+        mmap_search_close(ms);
+        return NULL;
+    }
+    ms->file_size = (size_t)st.st_size;
+    ms->count = ms->file_size / record_size;
+
+    if (ms->file_size > 0) {
+        void *p = mmap(NULL, ms->file_size, PROT_READ, MAP_SHARED, ms->fd, 0);
+        if (p == MAP_FAILED) {
+            mmap_search_close(ms);
+            return NULL;
+        }
+        ms->base = p;
+        // Доступ случайный — упреждающее чтение соседних страниц только мешает
+        madvise(p, ms->file_size, MADV_RANDOM);
+    }
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    ms->per_page = page_size > 0 ? (size_t)page_size / record_size : 0;
+    if (ms->per_page == 0) ms->per_page = 1;
+    ms->page_count = (ms->count + ms->per_page - 1) / ms->per_page;
+
+    ms->page_keys = malloc(sizeof(int) * (ms->page_count ? ms->page_count : 1));
+    if (!ms->page_keys) {
+        mmap_search_close(ms);
+        return NULL;
+    }
+    for (size_t p = 0; p < ms->page_count; p++) {
+        ms->page_keys[p] = mmap_key(ms, p * ms->per_page);
+    }
+    return ms;
+}
+
+void mmap_search_close(mmap_search_t *ms) {
+    if (!ms) return;
+    if (ms->base) munmap((void *)ms->base, ms->file_size);
+    if (ms->fd >= 0) close(ms->fd);
+    free(ms->page_keys);
+    free(ms);
+}
+
+// Номер первой записи с ключом >= key (count, если такой нет)
+size_t mmap_search_lower_bound(const mmap_search_t *ms, int key) {
+    if (ms->page_count == 0) return 0;
+
+    // Ответ лежит в последней странице, чей первый ключ < key, или в начале следующей
+    size_t page = isearch_lower_bound(ms->page_keys, ms->page_count, key);
+    if (page == 0) return 0;
+    page--;
+
+    size_t left = page * ms->per_page;
+    size_t right = left + ms->per_page;
+    if (right > ms->count) right = ms->count;
+    // Первый ключ страницы < key, ищем в (left, right)
+    left++;
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        if (mmap_key(ms, mid) < key) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+// Указатель на запись с ключом key внутри отображения или NULL
+const void *mmap_search_find(const mmap_search_t *ms, int key) {
+    size_t i = mmap_search_lower_bound(ms, key);
+    if (i >= ms->count || mmap_key(ms, i) != key) return NULL;
+    return ms->base + i * ms->record_size;
+}
@@ -0,0 +1,196 @@
+/**
+ * packed_ints.c
+ *
+ * Сжатый отсортированный массив int с поиском
+ *
+ * В отсортированном массиве разности соседних элементов обычно малы. Массив
+ * делится на блоки по 128 элементов; для каждого блока хранится первый
+ * элемент (несжатый, в отдельном массиве heads) и 127 разностей, упакованных
+ * ровно по ширине максимальной разности блока (frame of reference + bit
+ * packing). При разностях до 255 это 8 бит на элемент вместо 32.
+ *
+ * Поиск — бинарный поиск по heads (в 128 раз короче исходного массива) и
+ * распаковка одного блока: разности извлекаются из 64-битных окон без
+ * ветвлений, а префиксная сумма с SSE2 считается по 4 элемента за шаг
+ * (сдвиги регистра на 1 и 2 элемента и перенос последней суммы).
+ */
+
+#include "packed_ints.h"
+#include "search_types.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/* Число значащих битов v (0 для нуля) */
+static int packed_width(uint32_t v) {
+#if defined(__GNUC__)
+    return v ? 32 - __builtin_clz(v) : 0;
+#else
+    int n = 0;
+    while (v) {
+        v >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+packed_ints_t *packed_ints_build(const int arr[], int size) {
+    if (size < 0) return NULL;
+    packed_ints_t *p = calloc(1, sizeof(packed_ints_t));
+    if (!p) return NULL;
+    p->size = size;
+    p->block_count = (size + PACKED_INTS_BLOCK - 1) / PACKED_INTS_BLOCK;
+
+    size_t blocks = p->block_count ? (size_t)p->block_count : 1;
+    p->heads = malloc(sizeof(int) * blocks);
+    p->offset = malloc(sizeof(uint32_t) * blocks);
+    p->bits = malloc(blocks);
+    if (!p->heads || !p->offset || !p->bits) {
+        packed_ints_destroy(p);
+        return NULL;
+    }
+
+    // Ширины блоков и итоговый размер
+    size_t words = 0;
+    for (int b = 0; b < p->block_count; b++) {
+        int first = b * PACKED_INTS_BLOCK;
+        int last = first + PACKED_INTS_BLOCK < size ? first + PACKED_INTS_BLOCK : size;
+        uint32_t max_delta = 0;
+        for (int i = first + 1; i < last; i++) {
+            uint32_t d = (uint32_t)arr[i] - (uint32_t)arr[i - 1];
+            if (d > max_delta) max_delta = d;
+        }
+        p->heads[b] = arr[first];
+        p->bits[b] = (uint8_t)packed_width(max_delta);
+        p->offset[b] = (uint32_t)words;
+        words += ((size_t)(last - first - 1) * p->bits[b] + 31) / 32;
+    }
+
+    // +1 слово — распаковка читает по 64 бита
+    p->word_count = words + 1;
+    p->words = calloc(p->word_count, sizeof(uint32_t));
+    if (!p->words) {
+        packed_ints_destroy(p);
+        return NULL;
+    }
+
+    for (int b = 0; b < p->block_count; b++) {
+        int first = b * PACKED_INTS_BLOCK;
+        int last = first + PACKED_INTS_BLOCK < size ? first + PACKED_INTS_BLOCK : size;
+        uint32_t *w = p->words + p->offset[b];
+        int width = p->bits[b];
+        size_t bit = 0;
+        for (int i = first + 1; i < last; i++, bit += (size_t)width) {
+            uint64_t d = (uint32_t)arr[i] - (uint32_t)arr[i - 1];
+            size_t k = bit / 32;
+            unsigned shift = (unsigned)(bit % 32);
+            w[k] |= (uint32_t)(d << shift);
+            if (shift + (unsigned)width > 32) w[k + 1] |= (uint32_t)(d >> (32 - shift));
+        }
+    }
+    return p;
+}
+
+void packed_ints_destroy(packed_ints_t *p) {
+    if (!p) return;
+    free(p->heads);
+    free(p->offset);
+    free(p->bits);
+    free(p->words);
+    free(p);
+}
+
+/* Распаковывает блок в out; возвращает число элементов в нём */
+int packed_ints_decode_block(const packed_ints_t *p, int block, int out[PACKED_INTS_BLOCK]) {
+    int first = block * PACKED_INTS_BLOCK;
+    int n = p->size - first < PACKED_INTS_BLOCK ? p->size - first : PACKED_INTS_BLOCK;
+    const uint32_t *w = p->words + p->offset[block];
+    unsigned width = p->bits[block];
+    uint64_t mask = ((uint64_t)1 << width) - 1;
+
+    // out[i] — пока разность out[i] - out[i - 1], out[0] = head
+    uint32_t *u = (uint32_t *)out;
+    u[0] = (uint32_t)p->heads[block];
+    size_t bit = 0;
+    if (width == 0) {
+        // Все значения блока равны: слов под блок нет, читать нечего
+        for (int i = 1; i < n; i++) u[i] = 0;
+    } else {
+        for (int i = 1; i < n; i++, bit += width) {
+            uint64_t window = w[bit / 32] | ((uint64_t)w[bit / 32 + 1] << 32);
+            u[i] = (uint32_t)((window >> (bit % 32)) & mask);
+        }
+    }
+
+    // Префиксная сумма (арифметика по модулю 2^32, как и разности)
+    int i = 0;
+#if defined(__SSE2__)
+    __m128i carry = _mm_setzero_si128();
+    for (; i + 4 <= n; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(u + i));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+        x = _mm_add_epi32(x, carry);
+        _mm_storeu_si128((__m128i *)(u + i), x);
+        carry = _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3));
+    }
+    uint32_t acc = (uint32_t)_mm_cvtsi128_si32(carry);
+#else
+    uint32_t acc = 0;
+#endif
+    for (; i < n; i++) {
+        acc += u[i];
+        u[i] = acc;
+    }
+    return n;
+}
+
+int packed_ints_get(const packed_ints_t *p, int i) {
+    int block = i / PACKED_INTS_BLOCK;
+    int k = i - block * PACKED_INTS_BLOCK;
+    const uint32_t *w = p->words + p->offset[block];
+    unsigned width = p->bits[block];
+    uint64_t mask = ((uint64_t)1 << width) - 1;
+    uint32_t v = (uint32_t)p->heads[block];
+    if (width == 0) return (int)v;
+    size_t bit = 0;
+    for (int j = 1; j <= k; j++, bit += width) {
+        uint64_t window = w[bit / 32] | ((uint64_t)w[bit / 32 + 1] << 32);
+        v += (uint32_t)((window >> (bit % 32)) & mask);
+    }
+    return (int)v;
+}
+
+// Индекс первого элемента >= target (size, если такого нет)
+int packed_ints_lower_bound(const packed_ints_t *p, int target) {
+    if (p->block_count == 0) return 0;
+    // Ответ — в последнем блоке с head < target либо это начало следующего блока
+    int block = (int)isearch_lower_bound(p->heads, (size_t)p->block_count, target) - 1;
+    if (block < 0) return 0;
+    int buf[PACKED_INTS_BLOCK];
+    int n = packed_ints_decode_block(p, block, buf);
+    return block * PACKED_INTS_BLOCK + (int)isearch_lower_bound(buf, (size_t)n, target);
+}
+
+// Индекс элемента, равного target, или -1
+int packed_ints_search(const packed_ints_t *p, int target) {
+    if (p->block_count == 0) return -1;
+    int block = (int)isearch_upper_bound(p->heads, (size_t)p->block_count, target) - 1;
+    if (block < 0) return -1;
+    if (p->heads[block] == target) return block * PACKED_INTS_BLOCK;
+    int buf[PACKED_INTS_BLOCK];
+    int n = packed_ints_decode_block(p, block, buf);
+    size_t pos = isearch_lower_bound(buf, (size_t)n, target);
+    return (pos < (size_t)n && buf[pos] == target) ? block * PACKED_INTS_BLOCK + (int)pos : -1;
+}
+
+/* Занимаемая память в байтах */
+size_t packed_ints_bytes(const packed_ints_t *p) {
+    size_t blocks = (size_t)p->block_count;
+    return sizeof(packed_ints_t) + blocks * (sizeof(int) + sizeof(uint32_t) + 1)
+         + p->word_count * sizeof(uint32_t);
+}
@@ -0,0 +1,308 @@
+/**
+ * pma.c
+ *
+ * Packed-memory array (PMA) — отсортированный массив с быстрыми вставками
+ *
+ * Вставка в обычный отсортированный массив сдвигает в среднем n / 2
+ * элементов. PMA оставляет в массиве пропуски: массив из seg_num сегментов
+ * по seg_size ~ log2(N) ячеек, над сегментами — неявное полное бинарное
+ * дерево «окон» (окно уровня h — 2^h соседних сегментов).
+ *
+ * Для окна уровня h заданы допустимые плотности [rho_h, tau_h]: у листьев
+ * [1/8, 1], у корня [1/4, 3/4], между ними — линейная интерполяция.
+ *   - Вставка сдвигает элементы внутри одного сегмента. Если сегмент полон,
+ *     поднимаемся по уровням до первого окна, где плотность (с новым
+ *     элементом) не превышает tau_h, и равномерно перераспределяем его
+ *     элементы по сегментам. Если не подошёл даже корень — массив растёт.
+ *   - Удаление симметрично: при плотности сегмента ниже rho_0 ищется окно с
+ *     плотностью не ниже rho_h, при нехватке у корня массив сжимается.
+ * Амортизированная стоимость изменения — O(log^2 n) перемещений.
+ *
+ * Так как rho_h * seg_size >= 1, после любого перераспределения каждый
+ * сегмент непуст (кроме случая единственного сегмента), и поиск — это
+ * бинарный поиск по первым элементам сегментов и затем внутри сегмента.
+ * Последовательный обход копирует сегменты memcpy — со скоростью массива.
+ *
+ * Тестовый main — под макросом PMA_TEST.
+ */
+
+#include "pma.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define PMA_MIN_SEG 8
+
+#define PMA_RHO_LEAF 0.125
+#define PMA_RHO_ROOT 0.25
+#define PMA_TAU_LEAF 1.0
+#define PMA_TAU_ROOT 0.75
+
+static size_t pma_log2(size_t n) {
+    size_t h = 0;
+    while ((size_t)1 << (h + 1) <= n) h++;
+    return h;
+}
+
+/* Размер сегмента ~ log2(ёмкости), округлённый вверх до степени двойки */
+static size_t pma_seg_size_for(size_t capacity) {
+    size_t lg = pma_log2(capacity ? capacity : 1);
+    size_t s = PMA_MIN_SEG;
+    while (s < lg) s *= 2;
+    return s;
+}
+
+static double pma_upper(const pma_t *p, size_t h) {
+    size_t height = pma_log2(p->seg_num);
+    if (height == 0) return PMA_TAU_LEAF;
+    return PMA_TAU_LEAF - (PMA_TAU_LEAF - PMA_TAU_ROOT) * (double)h / (double)height;
+}
+
+static double pma_lower(const pma_t *p, size_t h) {
+    size_t height = pma_log2(p->seg_num);
+    if (height == 0) return 0.0;
+    return PMA_RHO_LEAF + (PMA_RHO_ROOT - PMA_RHO_LEAF) * (double)h / (double)height;
+}
+
+/* Равномерно раскладывает count элементов из buf по сегментам [first, first + segs) */
+static void pma_spread(pma_t *p, size_t first, size_t segs, const int *buf, size_t count) {
+    size_t base = count / segs;
+    size_t extra = count % segs;
+    for (size_t s = 0; s < segs; s++) {
+        size_t n = base + (s < extra);
+        p->seg_count[first + s] = (int)n;
+        if (n == 0) continue; // buf может быть NULL при пустой перестройке
+        memcpy(p->data + (first + s) * p->seg_size, buf, sizeof(int) * n);
+        buf += n;
+    }
+}
+
+/* Собирает элементы сегментов [first, first + segs) подряд в buf */
+static size_t pma_gather(const pma_t *p, size_t first, size_t segs, int *buf) {
+    size_t n = 0;
+    for (size_t s = first; s < first + segs; s++) {
+        memcpy(buf + n, p->data + s * p->seg_size, sizeof(int) * (size_t)p->seg_count[s]);
+        n += (size_t)p->seg_count[s];
+    }
+    return n;
+}
+
+/* Пересоздаёт массив под count элементов из buf: плотность корня в (1/4, 1/2] */
+static int pma_rebuild(pma_t *p, const int *buf, size_t count) {
+    size_t seg_size = PMA_MIN_SEG;
+    size_t seg_num = 1;
+    for (;;) {
+        seg_size = pma_seg_size_for(seg_num * seg_size);
+        if (count * 2 <= seg_num * seg_size || (seg_num == 1 && count <= seg_size / 2)) break;
+        seg_num *= 2;
+    }
+
+    int *data = malloc(sizeof(int) * seg_num * seg_size);
+    int *seg_count = malloc(sizeof(int) * seg_num);
+    if (!data || !seg_count) {
+        free(data);
+        free(seg_count);
+        return -1;
+    }
+    free(p->data);
+    free(p->seg_count);
+    p->data = data;
+    p->seg_count = seg_count;
+    p->seg_size = seg_size;
+    p->seg_num = seg_num;
+    p->count = count;
+    pma_spread(p, 0, seg_num, buf, count);
+    return 0;
+}
+
+pma_t *pma_create(void) {
+    pma_t *p = malloc(sizeof(pma_t));
+    if (!p) return NULL;
+    p->data = NULL;
+    p->seg_count = NULL;
+    if (pma_rebuild(p, NULL, 0) != 0) {
+        free(p);
+        return NULL;
+    }
+    return p;
+}
+
+void pma_destroy(pma_t *p) {
+    if (!p) return;
+    free(p->data);
+    free(p->seg_count);
+    free(p);
+}
+
+/* Сегмент, в котором должен лежать value: последний, чей первый элемент <= value */
+static size_t pma_find_segment(const pma_t *p, int value) {
+    size_t left = 0, right = p->seg_num; // ответ в [left, right)
+    while (right - left > 1) {
+        size_t mid = left + (right - left) / 2;
+        if (p->data[mid * p->seg_size] <= value) {
+            left = mid;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+/* Позиция первого элемента >= value внутри сегмента s */
+static size_t pma_segment_lower_bound(const pma_t *p, size_t s, int value) {
+    const int *seg = p->data + s * p->seg_size;
+    size_t left = 0, right = (size_t)p->seg_count[s];
+    while (left < right) {
+        size_t mid = left + (right - left) / 2;
+        if (seg[mid] < value) {
+            left = mid + 1;
+        } else {
+            right = mid;
+        }
+    }
+    return left;
+}
+
+bool pma_contains(const pma_t *p, int value) {
+    size_t s = pma_find_segment(p, value);
+    size_t i = pma_segment_lower_bound(p, s, value);
+    return i < (size_t)p->seg_count[s] && p->data[s * p->seg_size + i] == value;
+}
+
+int pma_insert(pma_t *p, int value) {
+    size_t s = pma_find_segment(p, value);
+    size_t cnt = (size_t)p->seg_count[s];
+
+    if (cnt < p->seg_size) {
+        int *seg = p->data + s * p->seg_size;
+        size_t i = pma_segment_lower_bound(p, s, value);
+        memmove(seg + i + 1, seg + i, sizeof(int) * (cnt - i));
+        seg[i] = value;
+        p->seg_count[s]++;
+        p->count++;
+        return 0;
+    }
+
+    // Сегмент полон: ищем окно, которое выдержит ещё один элемент
+    size_t height = pma_log2(p->seg_num);
+    size_t h = 1, first = s, segs = 1, window_count = cnt;
+    for (; h <= height; h++) {
+        segs = (size_t)1 << h;
+        first = s & ~(segs - 1);
+        window_count = 0;
+        for (size_t k = first; k < first + segs; k++) window_count += (size_t)p->seg_count[k];
+        if ((double)(window_count + 1) <= pma_upper(p, h) * (double)(segs * p->seg_size)) break;
+    }
+
+    bool grow = h > height;
+    if (grow) {
+        first = 0;
+        segs = p->seg_num;
+        window_count = p->count;
+    }
+
+    int *buf = malloc(sizeof(int) * (window_count + 1));
+    if (!buf) return -1;
+    pma_gather(p, first, segs, buf);
+    // Вставляем value в собранную последовательность
+    size_t i = window_count;
+    while (i > 0 && buf[i - 1] > value) {
+        buf[i] = buf[i - 1];
+        i--;
+    }
+    buf[i] = value;
+
+    int rc = 0;
+    if (grow) {
+        rc = pma_rebuild(p, buf, window_count + 1);
+    } else {
+        pma_spread(p, first, segs, buf, window_count + 1);
+        p->count++;
+    }
+    free(buf);
+    return rc;
+}
+
+int pma_delete(pma_t *p, int value) {
+    size_t s = pma_find_segment(p, value);
+    size_t cnt = (size_t)p->seg_count[s];
+    size_t i = pma_segment_lower_bound(p, s, value);
+    if (i >= cnt || p->data[s * p->seg_size + i] != value) return 0;
+
+    if ((double)(cnt - 1) >= pma_lower(p, 0) * (double)p->seg_size) {
+        int *seg = p->data + s * p->seg_size;
+        memmove(seg + i, seg + i + 1, sizeof(int) * (cnt - i - 1));
+        p->seg_count[s]--;
+        p->count--;
+        return 1;
+    }
+
+    // Сегмент станет слишком разрежен: ищем окно с допустимой плотностью после удаления.
+    // Удаляем уже в собранном буфере, чтобы при нехватке памяти массив остался прежним
+    size_t height = pma_log2(p->seg_num);
+    size_t h = 1, first = s, segs = 1, window_count = 0;
+    for (; h <= height; h++) {
+        segs = (size_t)1 << h;
+        first = s & ~(segs - 1);
+        window_count = 0;
+        for (size_t k = first; k < first + segs; k++) window_count += (size_t)p->seg_count[k];
+        if ((double)(window_count - 1) >= pma_lower(p, h) * (double)(segs * p->seg_size)) break;
+    }
+    if (h > height) {
+        first = 0;
+        segs = p->seg_num;
+        window_count = p->count;
+    }
+
+    int *buf = malloc(sizeof(int) * window_count);
+    if (!buf) return -1;
+    pma_gather(p, first, segs, buf);
+    size_t pos = i;
+    for (size_t k = first; k < s; k++) pos += (size_t)p->seg_count[k];
+    memmove(buf + pos, buf + pos + 1, sizeof(int) * (window_count - pos - 1));
+
+    int rc = 1;
+    if (h > height) {
+        if (pma_rebuild(p, buf, window_count - 1) != 0) rc = -1;
+    } else {
+        pma_spread(p, first, segs, buf, window_count - 1);
+        p->count--;
+    }
+    free(buf);
+    return rc;
+}
+
+// Копирует в out до max элементов >= from по возрастанию; возвращает их число
+size_t pma_scan(const pma_t *p, int from, int out[], size_t max) {
+    size_t s = pma_find_segment(p, from);
+    size_t i = pma_segment_lower_bound(p, s, from);
+    size_t n = 0;
+    for (; s < p->seg_num && n < max; s++, i = 0) {
+        size_t avail = (size_t)p->seg_count[s] - i;
+        if (avail > max - n) avail = max - n;
+        memcpy(out + n, p->data + s * p->seg_size + i, sizeof(int) * avail);
+        n += avail;
+    }
+    return n;
+}
+
+#ifdef PMA_TEST
+#include <stdio.h>
+
+int main(void) {
+    pma_t *p = pma_create();
+    for (int i = 0; i < 1000; i++) pma_insert(p, (i * 7919) % 1000);
+    printf("size = %zu, segments = %zu x %zu\n", p->count, p->seg_num, p->seg_size);
+
+    for (int i = 0; i < 1000; i += 2) pma_delete(p, i);
+    printf("contains(3) = %d, contains(4) = %d\n", pma_contains(p, 3), pma_contains(p, 4));
+
+    int out[10];
+    size_t n = pma_scan(p, 500, out, 10);
+    printf("first %zu elements >= 500: ", n);
+    for (size_t i = 0; i < n; i++) printf("%d ", out[i]);
+    printf("\n");
+
+    pma_destroy(p);
+    return 0;
+}
+#endif /* PMA_TEST */
@@ -0,0 +1,118 @@
+/**
+ * polynomial.c
+ *
+ * Вычисление многочленов: схема Горнера, схема Эстрина и пакетный вариант
+ *
+ * Горнер: p = p * x + c[i] — degree умножений-сложений, но каждое ждёт
+ *   предыдущее, и время определяется задержкой FMA (4-5 тактов), а не
+ *   пропускной способностью.
+ * Эстрин: соседние коэффициенты сливаются попарно (c0 + c1 x), пары — через
+ *   x^2, четвёрки — через x^4, так что цепочка зависимостей — log2 от длины.
+ *   Для высоких степеней коэффициенты режутся на блоки по 8: каждый блок
+ *   считается Эстрином (глубина 3), блоки между собой — Горнером по x^8.
+ *   Промежуточные суммы разные, поэтому результат может отличаться от
+ *   Горнера в последних битах.
+ * Пакетный вариант считает Горнером сразу много точек: независимые точки —
+ *   это и есть параллелизм, а Горнер делает меньше операций, чем Эстрин.
+ *   С AVX2 + FMA — 4 вектора по 4 точки в полёте. Результат побитно совпадает
+ *   с poly_horner.
+ */
+
+#include "polynomial.h"
+#include <math.h>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#define POLYNOMIAL_AVX2 1
+#endif
+
+/* a * b + c: одной инструкцией FMA, если она есть (иначе fma() — медленная программная) */
+#if defined(__FMA__)
+#define MADD(a, b, c) fma((a), (b), (c))
+#else
+#define MADD(a, b, c) ((a) * (b) + (c))
+#endif
+
+#define ESTRIN_BLOCK 8
+
+double poly_horner(const double coef[], size_t degree, double x) {
+    double p = coef[degree];
+    for (size_t i = degree; i-- > 0;) p = MADD(p, x, coef[i]);
+    return p;
+}
+
+/* Полный блок из 8 коэффициентов: 4 независимые пары, 2 четвёрки, итог */
+static inline double estrin8(const double c[], double x, double x2, double x4) {
+    double p01 = MADD(c[1], x, c[0]);
+    double p23 = MADD(c[3], x, c[2]);
+    double p45 = MADD(c[5], x, c[4]);
+    double p67 = MADD(c[7], x, c[6]);
+    double p03 = MADD(p23, x2, p01);
+    double p47 = MADD(p67, x2, p45);
+    return MADD(p47, x4, p03);
+}
+
+double poly_estrin(const double coef[], size_t degree, double x) {
+    size_t n = degree + 1;
+    size_t tail = n % ESTRIN_BLOCK;
+    size_t blocks = n / ESTRIN_BLOCK;
+
+    // Старший неполный блок (меньше 8 коэффициентов) — Горнером, он короткий
+    double p = tail ? poly_horner(coef + blocks * ESTRIN_BLOCK, tail - 1, x) : 0.0;
+    if (blocks == 0) return p;
+
+    double x2 = x * x;
+    double x4 = x2 * x2;
+    double x8 = x4 * x4;
+    // Блоки не зависят друг от друга; последовательна только свёртка по x^8
+    if (!tail) p = estrin8(coef + --blocks * ESTRIN_BLOCK, x, x2, x4);
+    while (blocks-- > 0) p = MADD(p, x8, estrin8(coef + blocks * ESTRIN_BLOCK, x, x2, x4));
+    return p;
+}
+
+void poly_eval_batch(const double coef[], size_t degree, const double x[], size_t count, double out[]) {
+    size_t i = 0;
+#if defined(POLYNOMIAL_AVX2)
+    __m256d top = _mm256_set1_pd(coef[degree]);
+    for (; i + 16 <= count; i += 16) {
+        __m256d x0 = _mm256_loadu_pd(x + i);
+        __m256d x1 = _mm256_loadu_pd(x + i + 4);
+        __m256d x2 = _mm256_loadu_pd(x + i + 8);
+        __m256d x3 = _mm256_loadu_pd(x + i + 12);
+        __m256d p0 = top, p1 = top, p2 = top, p3 = top;
+        for (size_t k = degree; k-- > 0;) {
+            __m256d c = _mm256_set1_pd(coef[k]);
+            p0 = _mm256_fmadd_pd(p0, x0, c);
+            p1 = _mm256_fmadd_pd(p1, x1, c);
+            p2 = _mm256_fmadd_pd(p2, x2, c);
+            p3 = _mm256_fmadd_pd(p3, x3, c);
+        }
+        _mm256_storeu_pd(out + i, p0);
+        _mm256_storeu_pd(out + i + 4, p1);
+        _mm256_storeu_pd(out + i + 8, p2);
+        _mm256_storeu_pd(out + i + 12, p3);
+    }
+    for (; i + 4 <= count; i += 4) {
+        __m256d vx = _mm256_loadu_pd(x + i);
+        __m256d p = top;
+        for (size_t k = degree; k-- > 0;) p = _mm256_fmadd_pd(p, vx, _mm256_set1_pd(coef[k]));
+        _mm256_storeu_pd(out + i, p);
+    }
+#else
+    // Четыре независимые цепочки; компилятор сводит их в векторные операции
+    for (; i + 4 <= count; i += 4) {
+        double p0 = coef[degree], p1 = p0, p2 = p0, p3 = p0;
+        for (size_t k = degree; k-- > 0;) {
+            p0 = MADD(p0, x[i], coef[k]);
+            p1 = MADD(p1, x[i + 1], coef[k]);
+            p2 = MADD(p2, x[i + 2], coef[k]);
+            p3 = MADD(p3, x[i + 3], coef[k]);
+        }
+        out[i] = p0;
+        out[i + 1] = p1;
+        out[i + 2] = p2;
+        out[i + 3] = p3;
+    }
+#endif
+    for (; i < count; i++) out[i] = poly_horner(coef, degree, x[i]);
+}
@@ -0,0 +1,428 @@
+/**
+ * rope.c
+ *
+ * Верёвка (rope) — строка в виде сбалансированного дерева кусков
+ *
+ * Листья хранят до ROPE_LEAF_MAX байт (несколько строк кэша — копирование
+ * листа дешевле лишнего уровня дерева), внутренние узлы — длину поддерева.
+ * Баланс — AVL по высоте: всё строится на join (склейка двух деревьев
+ * спуском по краю более высокого и поворотами на обратном пути) и split
+ * (разрез по позиции с пересклейкой половинок), оба за O(log n). Вставка —
+ * split и два join, подстрока — два split.
+ *
+ * Узлы неизменяемы и разделяются по счётчику ссылок. Исключение —
+ * дописывание в конец: если правый край дерева принадлежит только этой
+ * верёвке, а в последнем листе есть место, байты копируются прямо в него
+ * без выделения памяти. При склейке соседние листья сливаются, если
+ * помещаются в один, — мелкие куски не дробят дерево.
+ *
+ * Тестовый main — под макросом ROPE_TEST.
+ */
+
+#include "rope.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define ROPE_LEAF_MAX 1024
+
+struct rope_node {
+    size_t len;             /* байт в поддереве */
+    size_t refs;
+    int height;             /* 1 у листа */
+    rope_node_t *left;      /* NULL у листа */
+    rope_node_t *right;
+    char data[];            /* у листа — ROPE_LEAF_MAX байт */
+};
+
+static inline int node_height(const rope_node_t *n) {
+    return n ? n->height : 0;
+}
+
+static inline int is_leaf(const rope_node_t *n) {
+    return n->left == NULL;
+}
+
+static inline rope_node_t *retain(rope_node_t *n) {
+    if (n) n->refs++;
+    return n;
+}
+
+static void release(rope_node_t *n) {
+    if (!n || --n->refs > 0) return;
+    release(n->left);
+    release(n->right);
+    free(n);
+}
+
+static rope_node_t *leaf_new(const char *a, size_t alen, const char *b, size_t blen) {
+    rope_node_t *n = malloc(sizeof(rope_node_t) + ROPE_LEAF_MAX);
+    if (!n) return NULL;
+    n->len = alen + blen;
+    n->refs = 1;
+    n->height = 1;
+    n->left = NULL;
+    n->right = NULL;
+    memcpy(n->data, a, alen);
+    if (blen) memcpy(n->data + alen, b, blen);
+    return n;
+}
+
+/* Новый узел над l и r (ссылки на детей добавляются) */
+static rope_node_t *node_new(rope_node_t *l, rope_node_t *r) {
+    rope_node_t *n = malloc(sizeof(rope_node_t));
+    if (!n) return NULL;
+    n->len = l->len + r->len;
+    n->refs = 1;
+    n->height = 1 + (l->height > r->height ? l->height : r->height);
+    n->left = retain(l);
+    n->right = retain(r);
+    return n;
+}
+
+/* Узел над a и b, чьи высоты отличаются не больше чем на 2, с поворотом при перекосе */
+static rope_node_t *node_balanced(rope_node_t *a, rope_node_t *b) {
+    rope_node_t *t1, *t2, *res;
+    if (node_height(a) > node_height(b) + 1) {
+        if (node_height(a->left) >= node_height(a->right)) {
+            t1 = node_new(a->right, b);
+            res = t1 ? node_new(a->left, t1) : NULL;
+            release(t1);
+            return res;
+        }
+        t1 = node_new(a->left, a->right->left);
+        t2 = node_new(a->right->right, b);
+    } else if (node_height(b) > node_height(a) + 1) {
+        if (node_height(b->right) >= node_height(b->left)) {
+            t1 = node_new(a, b->left);
+            res = t1 ? node_new(t1, b->right) : NULL;
+            release(t1);
+            return res;
+        }
+        t1 = node_new(a, b->left->left);
+        t2 = node_new(b->left->right, b->right);
+    } else {
+        return node_new(a, b);
+    }
+    res = t1 && t2 ? node_new(t1, t2) : NULL;
+    release(t1);
+    release(t2);
+    return res;
+}
+
+/* Длина крайнего (левого или правого) листа */
+static size_t edge_leaf_len(const rope_node_t *n, int rightmost) {
+    while (!is_leaf(n)) n = rightmost ? n->right : n->left;
+    return n->len;
+}
+
+/*
+ * Склейка l и r (NULL — пустая строка); возвращает новую ссылку или NULL
+ * при нехватке памяти, сами l и r не меняются. Спуск идёт по краю более
+ * высокого дерева; merge_right / merge_left — r (или l) — один лист,
+ * который поместится в крайний лист другого дерева: тогда спуск идёт до
+ * этого листа и они сливаются.
+ */
+static rope_node_t *join_rec(rope_node_t *l, rope_node_t *r, int merge_right, int merge_left) {
+    if (!l) return retain(r);
+    if (!r) return retain(l);
+    if (is_leaf(l) && is_leaf(r) && l->len + r->len <= ROPE_LEAF_MAX) {
+        return leaf_new(l->data, l->len, r->data, r->len);
+    }
+
+    rope_node_t *t, *res;
+    int hl = l->height;
+    int hr = r->height;
+    if (!is_leaf(l) && (hl > hr + 1 || merge_right)) {
+        t = join_rec(l->right, r, merge_right, 0);
+        res = t ? node_balanced(l->left, t) : NULL;
+    } else if (!is_leaf(r) && (hr > hl + 1 || merge_left)) {
+        t = join_rec(l, r->left, 0, merge_left);
+        res = t ? node_balanced(t, r->right) : NULL;
+    } else {
+        return node_new(l, r);
+    }
+    release(t);
+    return res;
+}
+
+static int split(rope_node_t *t, size_t pos, rope_node_t **a, rope_node_t **b);
+
+/*
+ * Склейка с уплотнением шва: если крайние листья l и r вместе помещаются в
+ * один, они сливаются (первый лист r переносится в конец l), иначе после
+ * вставок в середину дерево обрастало бы полупустыми листьями.
+ */
+static rope_node_t *join(rope_node_t *l, rope_node_t *r) {
+    if (!l) return retain(r);
+    if (!r) return retain(l);
+    size_t tail = edge_leaf_len(l, 1);
+    size_t head = edge_leaf_len(r, 0);
+    if (tail + head > ROPE_LEAF_MAX) return join_rec(l, r, 0, 0);
+    if (is_leaf(l) || is_leaf(r)) return join_rec(l, r, is_leaf(r), is_leaf(l));
+
+    rope_node_t *first, *rest;
+    if (split(r, head, &first, &rest) != 0) return NULL;
+    rope_node_t *t = join_rec(l, first, 1, 0);
+    rope_node_t *res = t ? join_rec(t, rest, 0, 0) : NULL;
+    release(first);
+    release(rest);
+    release(t);
+    return res;
+}
+
+/* Разрез t на [0, pos) и [pos, len): новые ссылки в *a и *b; 0 или -1 */
+static int split(rope_node_t *t, size_t pos, rope_node_t **a, rope_node_t **b) {
+    *a = NULL;
+    *b = NULL;
+    if (!t) return 0;
+    if (pos == 0) {
+        *b = retain(t);
+        return 0;
+    }
+    if (pos >= t->len) {
+        *a = retain(t);
+        return 0;
+    }
+    if (is_leaf(t)) {
+        *a = leaf_new(t->data, pos, NULL, 0);
+        *b = leaf_new(t->data + pos, t->len - pos, NULL, 0);
+    } else if (pos == t->left->len) {
+        *a = retain(t->left);
+        *b = retain(t->right);
+    } else if (pos < t->left->len) {
+        rope_node_t *lr;
+        if (split(t->left, pos, a, &lr) != 0) return -1;
+        *b = join_rec(lr, t->right, 0, 0);
+        release(lr);
+    } else {
+        rope_node_t *rl;
+        if (split(t->right, pos - t->left->len, &rl, b) != 0) return -1;
+        *a = join_rec(t->left, rl, 0, 0);
+        release(rl);
+    }
+    if (!*a || !*b) {
+        release(*a);
+        release(*b);
+        *a = NULL;
+        *b = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+/* Сбалансированное дерево из count листов по ROPE_LEAF_MAX байт (последний — остаток) */
+static rope_node_t *build(const char *s, size_t len, size_t count) {
+    if (count == 1) return leaf_new(s, len, NULL, 0);
+    size_t half = count / 2;
+    size_t left_len = half * ROPE_LEAF_MAX;
+    rope_node_t *l = build(s, left_len, half);
+    rope_node_t *r = l ? build(s + left_len, len - left_len, count - half) : NULL;
+    rope_node_t *n = r ? node_new(l, r) : NULL;
+    release(l);
+    release(r);
+    return n;
+}
+
+static rope_node_t *from_string(const char *s, size_t len) {
+    if (len == 0) return NULL;
+    return build(s, len, (len + ROPE_LEAF_MAX - 1) / ROPE_LEAF_MAX);
+}
+
+static void copy_range(const rope_node_t *n, size_t pos, size_t len, char *out) {
+    while (len > 0) {
+        if (is_leaf(n)) {
+            memcpy(out, n->data + pos, len);
+            return;
+        }
+        size_t left_len = n->left->len;
+        if (pos < left_len) {
+            size_t part = left_len - pos < len ? left_len - pos : len;
+            copy_range(n->left, pos, part, out);
+            out += part;
+            len -= part;
+            pos = 0;
+        } else {
+            pos -= left_len;
+        }
+        n = n->right;
+    }
+}
+
+/* Новый корень вместо старого; кэш плоской строки больше не действителен */
+static void set_root(rope_t *r, rope_node_t *root) {
+    release(r->root);
+    r->root = root;
+    free(r->flat);
+    r->flat = NULL;
+}
+
+rope_t *rope_create(void) {
+    rope_t *r = malloc(sizeof(rope_t));
+    if (!r) return NULL;
+    r->root = NULL;
+    r->flat = NULL;
+    return r;
+}
+
+void rope_destroy(rope_t *r) {
+    if (!r) return;
+    release(r->root);
+    free(r->flat);
+    free(r);
+}
+
+size_t rope_length(const rope_t *r) {
+    return r->root ? r->root->len : 0;
+}
+
+char rope_at(const rope_t *r, size_t pos) {
+    const rope_node_t *n = r->root;
+    if (!n || pos >= n->len) return '\0';
+    while (!is_leaf(n)) {
+        if (pos < n->left->len) {
+            n = n->left;
+        } else {
+            pos -= n->left->len;
+            n = n->right;
+        }
+    }
+    return n->data[pos];
+}
+
+/* Копия [pos, pos + len) в out (обрезается по длине строки); число скопированных байт */
+size_t rope_copy(const rope_t *r, size_t pos, size_t len, char *out) {
+    size_t total = rope_length(r);
+    if (pos >= total) return 0;
+    if (len > total - pos) len = total - pos;
+    copy_range(r->root, pos, len, out);
+    return len;
+}
+
+const char *rope_flatten(rope_t *r) {
+    if (r->flat) return r->flat;
+    size_t len = rope_length(r);
+    r->flat = malloc(len + 1);
+    if (!r->flat) return NULL;
+    if (len) copy_range(r->root, 0, len, r->flat);
+    r->flat[len] = '\0';
+    return r->flat;
+}
+
+int rope_append(rope_t *r, const char *s, size_t len) {
+    if (len == 0) return 0;
+
+    // Быстрый путь: правый край только наш и в последнем листе есть место
+    rope_node_t *n = r->root;
+    while (n && n->refs == 1 && !is_leaf(n)) n = n->right;
+    if (n && n->refs == 1 && ROPE_LEAF_MAX - n->len >= len) {
+        memcpy(n->data + n->len, s, len);
+        for (n = r->root; !is_leaf(n); n = n->right) n->len += len;
+        n->len += len;
+        free(r->flat);
+        r->flat = NULL;
+        return 0;
+    }
+
+    rope_node_t *piece = from_string(s, len);
+    rope_node_t *root = piece ? join(r->root, piece) : NULL;
+    release(piece);
+    if (!root) return -1;
+    set_root(r, root);
+    return 0;
+}
+
+int rope_insert(rope_t *r, size_t pos, const char *s, size_t len) {
+    if (pos > rope_length(r)) return -1;
+    if (pos == rope_length(r)) return rope_append(r, s, len);
+    if (len == 0) return 0;
+
+    rope_node_t *a, *b;
+    rope_node_t *piece = from_string(s, len);
+    if (!piece) return -1;
+    if (split(r->root, pos, &a, &b) != 0) {
+        release(piece);
+        return -1;
+    }
+    rope_node_t *head = join(a, piece);
+    rope_node_t *root = head ? join(head, b) : NULL;
+    release(a);
+    release(b);
+    release(piece);
+    release(head);
+    if (!root) return -1;
+    set_root(r, root);
+    return 0;
+}
+
+/* Дописывает other в конец r; узлы other разделяются, other не меняется */
+int rope_concat(rope_t *r, const rope_t *other) {
+    if (!other->root) return 0;
+    rope_node_t *root = join(r->root, other->root);
+    if (!root) return -1;
+    set_root(r, root);
+    return 0;
+}
+
+/* r сохраняет [0, pos), возвращается новая верёвка с [pos, len) */
+rope_t *rope_split(rope_t *r, size_t pos) {
+    rope_t *tail = rope_create();
+    if (!tail) return NULL;
+    rope_node_t *a, *b;
+    if (split(r->root, pos, &a, &b) != 0) {
+        rope_destroy(tail);
+        return NULL;
+    }
+    set_root(r, a);
+    tail->root = b;
+    return tail;
+}
+
+rope_t *rope_substr(const rope_t *r, size_t pos, size_t len) {
+    rope_t *sub = rope_create();
+    if (!sub) return NULL;
+    size_t total = rope_length(r);
+    if (pos >= total || len == 0) return sub;
+    if (len > total - pos) len = total - pos;
+
+    rope_node_t *a, *b, *c, *d;
+    if (split(r->root, pos, &a, &b) != 0) {
+        rope_destroy(sub);
+        return NULL;
+    }
+    int status = split(b, len, &c, &d);
+    release(a);
+    release(b);
+    release(d);
+    if (status != 0) {
+        rope_destroy(sub);
+        return NULL;
+    }
+    sub->root = c;
+    return sub;
+}
+
+#ifdef ROPE_TEST
+#include <stdio.h>
+
+int main(void) {
+    rope_t *r = rope_create();
+    for (int i = 0; i < 10000; i++) {
+        char line[32];
+        int n = snprintf(line, sizeof(line), "line %d\n", i);
+        rope_append(r, line, (size_t)n);
+    }
+    rope_insert(r, 0, "header\n", 7);
+    printf("length = %zu, height = %d\n", rope_length(r), r->root->height);
+
+    rope_t *sub = rope_substr(r, 7, 14);
+    printf("substr(7, 14) = \"%s\"\n", rope_flatten(sub));
+
+    rope_t *tail = rope_split(r, rope_length(r) - 10);
+    printf("tail = \"%s\"\n", rope_flatten(tail));
+
+    rope_destroy(sub);
+    rope_destroy(tail);
+    rope_destroy(r);
+    return 0;
+}
+#endif /* ROPE_TEST */
@@ -0,0 +1,118 @@
+/**
+ * stree.c
+ *
+ * Статическое B+-дерево (S-tree) с неявной индексацией
+ *
+ * Каждый узел — блок из STREE_B = 16 отсортированных ключей (ровно кэш-линия),
+ * у узла k ровно B + 1 потомков с номерами k * (B + 1) + i, поэтому указатели
+ * не хранятся. Нижний слой — сам исходный массив, разбитый на блоки
+ * (дополненный INT_MAX), над ним слои, где ключ j узла — минимальный элемент
+ * поддерева его (j + 1)-го потомка.
+ *
+ * Поиск в узле — это подсчёт ключей меньше искомого: с AVX2 два сравнения по
+ * 8 int, movemask и popcount, без AVX2 — скалярный цикл без ветвлений.
+ * Спуск касается одной кэш-линии на уровень: log_17(n) промахов вместо log2(n).
+ *
+ * Сложности:
+ *   - построение: O(n), память: n * (1 + 1/16 + ...) int
+ *   - поиск: O(log_17 n) узлов
+ */
+
+#include "stree.h"
+#include <limits.h>
+#include <stdlib.h>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+static size_t stree_blocks(size_t n) {
+    return (n + STREE_B - 1) / STREE_B;
+}
+
+/* Сколько ключей нужно слою над слоем из n ключей */
+static size_t stree_prev_keys(size_t n) {
+    return (stree_blocks(n) + STREE_B) / (STREE_B + 1) * STREE_B;
+}
+
+/* Количество ключей узла, меньших target */
+static inline unsigned stree_rank(const int *node, int target) {
+#if defined(__AVX2__)
+    __m256i x = _mm256_set1_epi32(target);
+    __m256i lo = _mm256_load_si256((const __m256i *)node);
+    __m256i hi = _mm256_load_si256((const __m256i *)(node + 8));
+    unsigned mask_lo = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, lo)));
+    unsigned mask_hi = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, hi)));
+    return (unsigned)__builtin_popcount(mask_lo | (mask_hi << 8));
+#else
+    unsigned rank = 0;
+    for (int i = 0; i < STREE_B; i++) {
+        rank += node[i] < target;
+    }
+    return rank;
+#endif
+}
+
+stree_t *stree_build(const int arr[], int size) {
+    if (size < 0) return NULL;
+    stree_t *t = malloc(sizeof(stree_t));
+    if (!t) return NULL;
+    t->size = size;
+
+    // Размеры слоёв снизу вверх; у пустого массива всё равно один лист из INT_MAX
+    size_t n = (size_t)size;
+    size_t total = 0;
+    int h = 0;
+    for (;;) {
+        t->offset[h++] = total;
+        total += (n ? stree_blocks(n) : 1) * STREE_B;
+        if (n <= STREE_B) break;
+        n = stree_prev_keys(n);
+    }
+    t->offset[h] = total;
+    t->height = h;
+
+    t->tree = aligned_alloc(64, total * sizeof(int));
+    if (!t->tree) {
+        free(t);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < (size_t)size; i++) t->tree[i] = arr[i];
+    for (size_t i = (size_t)size; i < t->offset[1]; i++) t->tree[i] = INT_MAX;
+
+    // Ключ j узла k слоя h — первый элемент самого левого листа (j + 1)-го потомка
+    for (h = 1; h < t->height; h++) {
+        size_t keys = t->offset[h + 1] - t->offset[h];
+        for (size_t i = 0; i < keys; i++) {
+            size_t k = i / STREE_B;
+            size_t j = i - k * STREE_B;
+            k = k * (STREE_B + 1) + j + 1;
+            for (int l = 1; l < h; l++) k *= STREE_B + 1;
+            t->tree[t->offset[h] + i] = k * STREE_B < (size_t)size ? t->tree[k * STREE_B] : INT_MAX;
+        }
+    }
+    return t;
+}
+
+void stree_destroy(stree_t *t) {
+    if (!t) return;
+    free(t->tree);
+    free(t);
+}
+
+// Индекс первого элемента >= target (size, если такого нет)
+int stree_lower_bound(const stree_t *t, int target) {
+    size_t k = 0;
+    for (int h = t->height - 1; h > 0; h--) {
+        k = k * (STREE_B + 1) + stree_rank(t->tree + t->offset[h] + k * STREE_B, target);
+    }
+    size_t pos = k * STREE_B + stree_rank(t->tree + k * STREE_B, target);
+    return pos < (size_t)t->size ? (int)pos : t->size;
+}
+
+// Индекс элемента, равного target, или -1
+int stree_search(const stree_t *t, int target) {
+    int pos = stree_lower_bound(t, target);
+    return (pos < t->size && t->tree[pos] == target) ? pos : -1;
+}
@@ -3,11 +3,15 @@
 #include <string.h>
 #include <limits.h>
 
-#define CONCAT_OK        0
-#define CONCAT_OVERFLOW  1
-#define CONCAT_BAD_FIRST 2
-#define CONCAT_ALLOC_ERR 3
+#include "string_concatinate.h"
 
+/* Длины первых аргументов запоминаются, чтобы не считать strlen дважды */
+#define CONCAT_CACHED_LENS 32
+
+/*
+ * Два прохода по аргументам: первый считает итоговую длину, второй
+ * копирует, так что память выделяется ровно один раз.
+ */
 int concat(char **result, char *first, ...)
 {
     if (!result || !first)
@@ -15,50 +19,40 @@ int concat(char **result, char *first, ...)
 
     *result = NULL;
 
-    size_t capacity = 16;
-    size_t len = 0;
-
-    char *buf = malloc(capacity);
-    if (!buf)
-        return CONCAT_ALLOC_ERR;
+    size_t lens[CONCAT_CACHED_LENS];
+    size_t count = 0;
+    size_t total = 0;
 
     va_list ap;
     va_start(ap, first);
 
-    char *s = first;
-
-    while (s) {
+    for (char *s = first; s; s = va_arg(ap, char *), count++) {
         size_t slen = strlen(s);
+        if (count < CONCAT_CACHED_LENS)
+            lens[count] = slen;
 
         /* Проверка переполнения size_t */
-        if (len > __SIZE_MAX__ - slen - 1) {
-            free(buf);
+        if (total > __SIZE_MAX__ - slen - 1) {
             va_end(ap);
             return CONCAT_OVERFLOW;
         }
+        total += slen;
+    }
 
-        /* Расширение буфера при необходимости */
-        while (len + slen + 1 > capacity) {
-            if (capacity > __SIZE_MAX__ / 2) {
-                free(buf);
-                va_end(ap);
-                return CONCAT_OVERFLOW;
-            }
-
-            capacity *= 2;
-            char *tmp = realloc(buf, capacity);
-            if (!tmp) {
-                free(buf);
-                va_end(ap);
-                return CONCAT_ALLOC_ERR;
-            }
-            buf = tmp;
-        }
+    va_end(ap);
 
+    char *buf = malloc(total + 1);
+    if (!buf)
+        return CONCAT_ALLOC_ERR;
+
+    size_t len = 0;
+    count = 0;
+    va_start(ap, first);
+
+    for (char *s = first; s; s = va_arg(ap, char *), count++) {
+        size_t slen = count < CONCAT_CACHED_LENS ? lens[count] : strlen(s);
         memcpy(buf + len, s, slen);
         len += slen;
-
-        s = va_arg(ap, char *);
     }
 
     va_end(ap);
@@ -68,3 +62,117 @@ int concat(char **result, char *first, ...)
 
     return CONCAT_OK;
 }
+
+int concat_views(char **result, const str_view_t *parts, size_t count)
+{
+    if (!result || (!parts && count))
+        return CONCAT_BAD_FIRST;
+
+    *result = NULL;
+
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (total > __SIZE_MAX__ - parts[i].len - 1)
+            return CONCAT_OVERFLOW;
+        total += parts[i].len;
+    }
+
+    char *buf = malloc(total + 1);
+    if (!buf)
+        return CONCAT_ALLOC_ERR;
+
+    size_t len = 0;
+    for (size_t i = 0; i < count; i++) {
+        memcpy(buf + len, parts[i].ptr, parts[i].len);
+        len += parts[i].len;
+    }
+
+    buf[len] = '\0';
+    *result = buf;
+
+    return CONCAT_OK;
+}
+
+int str_builder_init(str_builder_t *sb, size_t capacity)
+{
+    sb->len = 0;
+    sb->cap = 0;
+    sb->status = CONCAT_OK;
+
+    if (capacity > __SIZE_MAX__ - 1) {
+        sb->buf = NULL;
+        sb->status = CONCAT_OVERFLOW;
+        return sb->status;
+    }
+
+    /* Лишний байт — под завершающий ноль в str_builder_finish */
+    sb->buf = malloc(capacity + 1);
+    if (!sb->buf) {
+        sb->status = CONCAT_ALLOC_ERR;
+        return sb->status;
+    }
+    sb->cap = capacity;
+
+    return CONCAT_OK;
+}
+
+/* Место ещё под extra байт; при нехватке ёмкость удваивается */
+int str_builder_reserve(str_builder_t *sb, size_t extra)
+{
+    if (sb->status != CONCAT_OK)
+        return sb->status;
+    if (extra <= sb->cap - sb->len)
+        return CONCAT_OK;
+
+    if (sb->len > __SIZE_MAX__ - extra - 1) {
+        sb->status = CONCAT_OVERFLOW;
+        return sb->status;
+    }
+
+    size_t need = sb->len + extra;
+    size_t capacity = sb->cap > __SIZE_MAX__ / 2 - 1 ? need : sb->cap * 2;
+    if (capacity < need)
+        capacity = need;
+
+    char *tmp = realloc(sb->buf, capacity + 1);
+    if (!tmp) {
+        sb->status = CONCAT_ALLOC_ERR;
+        return sb->status;
+    }
+    sb->buf = tmp;
+    sb->cap = capacity;
+
+    return CONCAT_OK;
+}
+
+/* Отдаёт собранную строку в *result; сборщик после этого пуст */
+int str_builder_finish(str_builder_t *sb, char **result)
+{
+    int status = sb->status;
+
+    if (!result)
+        status = CONCAT_BAD_FIRST;
+
+    if (status != CONCAT_OK) {
+        str_builder_free(sb);
+        if (result)
+            *result = NULL;
+        return status;
+    }
+
+    sb->buf[sb->len] = '\0';
+    *result = sb->buf;
+    sb->buf = NULL;
+    sb->len = 0;
+    sb->cap = 0;
+
+    return CONCAT_OK;
+}
+
+void str_builder_free(str_builder_t *sb)
+{
+    free(sb->buf);
+    sb->buf = NULL;
+    sb->len = 0;
+    sb->cap = 0;
+}
@@ -0,0 +1,207 @@
+/**
+ * string_index.c
+ *
+ * Поиск в отсортированном словаре строк с front coding
+ *
+ * Соседние строки словаря (URL, пути) обычно имеют длинный общий префикс.
+ * Front coding хранит для каждой строки, кроме первой в блоке, только длину
+ * общего префикса с предыдущей строкой и оставшийся суффикс — словарь
+ * занимает меньше памяти, а блок читается последовательно.
+ *
+ * Поиск:
+ *   1) бинарный поиск по первым строкам блоков; помним длины общих префиксов
+ *      ключа с левой и правой границами (llcp, rlcp) — префикс длины
+ *      min(llcp, rlcp) совпадает у ключа и у любого пробника между ними,
+ *      поэтому сравнение начинается с этой позиции;
+ *   2) проход по одному блоку: пусть m — общий префикс ключа с текущей
+ *      строкой (она меньше ключа), p — общий префикс следующей строки с
+ *      текущей. Если p > m, следующая строка тоже меньше ключа (символ m не
+ *      изменился); если p < m, она больше ключа и поиск окончен; и только при
+ *      p == m сравнивается суффикс — с позиции m, а не с начала.
+ */
+
+#include "string_index.h"
+#include <stdlib.h>
+#include <string.h>
+
+static size_t varint_size(size_t v) {
+    size_t n = 1;
+    while (v >= 0x80) {
+        v >>= 7;
+        n++;
+    }
+    return n;
+}
+
+static unsigned char *varint_put(unsigned char *p, size_t v) {
+    while (v >= 0x80) {
+        *p++ = (unsigned char)(v | 0x80);
+        v >>= 7;
+    }
+    *p++ = (unsigned char)v;
+    return p;
+}
+
+static const unsigned char *varint_get(const unsigned char *p, size_t *v) {
+    size_t result = 0;
+    int shift = 0;
+    while (*p & 0x80) {
+        result |= (size_t)(*p++ & 0x7F) << shift;
+        shift += 7;
+    }
+    *v = result | ((size_t)*p++ << shift);
+    return p;
+}
+
+static size_t common_prefix(const char *a, const char *b) {
+    size_t i = 0;
+    while (a[i] != '\0' && a[i] == b[i]) i++;
+    return i;
+}
+
+/* Сравнение key и s, начиная с позиции from (первые from символов равны); *lcp — общий префикс */
+static int compare_from(const char *key, const char *s, size_t from, size_t *lcp) {
+    size_t i = from;
+    while (key[i] != '\0' && key[i] == s[i]) i++;
+    *lcp = i;
+    return (int)(unsigned char)key[i] - (int)(unsigned char)s[i];
+}
+
+string_index_t *string_index_build(const char *const strs[], size_t count) {
+    string_index_t *si = malloc(sizeof(string_index_t));
+    if (!si) return NULL;
+    si->count = count;
+    si->block_count = (count + STRING_INDEX_BLOCK - 1) / STRING_INDEX_BLOCK;
+
+    // Первый проход — точный размер закодированных данных
+    size_t total = 0;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = strlen(strs[i]);
+        if (i % STRING_INDEX_BLOCK == 0) {
+            total += len + 1;
+        } else {
+            size_t lcp = common_prefix(strs[i - 1], strs[i]);
+            total += varint_size(lcp) + varint_size(len - lcp) + len - lcp;
+        }
+    }
+
+    si->data = malloc(total ? total : 1);
+    si->block_offset = malloc(sizeof(size_t) * (si->block_count ? si->block_count : 1));
+    si->heads = malloc(sizeof(char *) * (si->block_count ? si->block_count : 1));
+    if (!si->data || !si->block_offset || !si->heads) {
+        string_index_destroy(si);
+        return NULL;
+    }
+
+    unsigned char *p = si->data;
+    for (size_t i = 0; i < count; i++) {
+        size_t len = strlen(strs[i]);
+        if (i % STRING_INDEX_BLOCK == 0) {
+            // Первая строка блока целиком, с '\0' — к ней можно обращаться как к C-строке
+            size_t b = i / STRING_INDEX_BLOCK;
+            si->block_offset[b] = (size_t)(p - si->data);
+            si->heads[b] = (const char *)p;
+            memcpy(p, strs[i], len + 1);
+            p += len + 1;
+        } else {
+            size_t lcp = common_prefix(strs[i - 1], strs[i]);
+            p = varint_put(p, lcp);
+            p = varint_put(p, len - lcp);
+            memcpy(p, strs[i] + lcp, len - lcp);
+            p += len - lcp;
+        }
+    }
+    return si;
+}
+
+void string_index_destroy(string_index_t *si) {
+    if (!si) return;
+    free(si->data);
+    free(si->block_offset);
+    free(si->heads);
+    free(si);
+}
+
+// Номер строки key в словаре или -1
+long string_index_search(const string_index_t *si, const char *key) {
+    if (si->block_count == 0) return -1;
+
+    // Последний блок, чья первая строка <= key
+    size_t lcp;
+    int cmp = compare_from(key, si->heads[0], 0, &lcp);
+    if (cmp < 0) return -1;
+    if (cmp == 0) return 0;
+
+    size_t left = 0, right = si->block_count; // heads[left] < key, heads[right] > key (или за концом)
+    size_t llcp = lcp, rlcp = 0;
+    while (right - left > 1) {
+        size_t mid = left + (right - left) / 2;
+        size_t from = llcp < rlcp ? llcp : rlcp;
+        cmp = compare_from(key, si->heads[mid], from, &lcp);
+        if (cmp == 0) return (long)(mid * STRING_INDEX_BLOCK);
+        if (cmp > 0) {
+            left = mid;
+            llcp = lcp;
+        } else {
+            right = mid;
+            rlcp = lcp;
+        }
+    }
+
+    // Проход по блоку left: m — общий префикс ключа с текущей строкой (она < key)
+    size_t block = left;
+    size_t first = block * STRING_INDEX_BLOCK;
+    size_t last = first + STRING_INDEX_BLOCK;
+    if (last > si->count) last = si->count;
+
+    const unsigned char *p = (const unsigned char *)si->heads[block];
+    p += strlen((const char *)p) + 1;
+    size_t m = llcp;
+    for (size_t i = first + 1; i < last; i++) {
+        size_t prefix, suffix_len;
+        p = varint_get(p, &prefix);
+        p = varint_get(p, &suffix_len);
+        const char *suffix = (const char *)p;
+        p += suffix_len;
+
+        if (prefix > m) continue; // Совпадает с предыдущей дальше, чем ключ — всё ещё меньше
+        if (prefix < m) return -1; // Отличается раньше ключа — уже больше
+
+        size_t j = 0;
+        while (j < suffix_len && key[m + j] == suffix[j]) j++;
+        if (j == suffix_len) {
+            if (key[m + j] == '\0') return (long)i;
+        } else if ((unsigned char)key[m + j] < (unsigned char)suffix[j]) {
+            return -1;
+        }
+        m += j;
+    }
+    return -1;
+}
+
+/* Восстанавливает i-ю строку в buf; возвращает её длину (как snprintf — без учёта усечения) */
+size_t string_index_get(const string_index_t *si, size_t i, char *buf, size_t buf_size) {
+    if (i >= si->count) return 0;
+    size_t block = i / STRING_INDEX_BLOCK;
+    const char *head = si->heads[block];
+    size_t len = strlen(head);
+    if (buf_size > 0) {
+        size_t n = len < buf_size - 1 ? len : buf_size - 1;
+        memcpy(buf, head, n);
+    }
+
+    const unsigned char *p = (const unsigned char *)head + len + 1;
+    for (size_t k = block * STRING_INDEX_BLOCK + 1; k <= i; k++) {
+        size_t prefix, suffix_len;
+        p = varint_get(p, &prefix);
+        p = varint_get(p, &suffix_len);
+        if (prefix < buf_size) {
+            size_t n = prefix + suffix_len < buf_size - 1 ? suffix_len : buf_size - 1 - prefix;
+            memcpy(buf + prefix, p, n);
+        }
+        p += suffix_len;
+        len = prefix + suffix_len;
+    }
+    if (buf_size > 0) buf[len < buf_size - 1 ? len : buf_size - 1] = '\0';
+    return len;
+}